@@ -9,5 +9,6 @@
 #include "SSVUtils/Container/Inc/VecMapBase.hpp"
 #include "SSVUtils/Container/Inc/VecSorted.hpp"
 #include "SSVUtils/Container/Inc/VecMap.hpp"
+#include "SSVUtils/Container/Inc/VecHashMap.hpp"
 
 #endif
@@ -0,0 +1,277 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_IMPL_CONTAINER_VECHASHMAP
+#define SSVU_IMPL_CONTAINER_VECHASHMAP
+
+#include "SSVUtils/Core/Common/Aliases.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+#include <utility>
+
+namespace ssvu
+{
+/// @brief Map-like insertion-ordered container implemented on top of an
+/// `std::vector`.
+/// @details Key/value pairs are stored in insertion order. Small maps are
+/// searched linearly; past `indexThreshold` items, an open-addressing hash
+/// index makes insertion and lookup O(1).
+/// @tparam TK Key type.
+/// @tparam TV Value type.
+/// @tparam THash Hash function object for `TK`.
+template <typename TK, typename TV, typename THash = std::hash<TK>>
+class VecHashMap
+{
+public:
+    /// @typedef Type of object stored in the internal vector.
+    using Item = std::pair<TK, TV>;
+
+    /// @brief Number of items past which the hash index is used.
+    static constexpr std::size_t indexThreshold{16};
+
+private:
+    std::vector<Item> data;
+
+    /// @brief Open-addressing table of indices in `data`, plus one. Zero
+    /// marks an empty slot. Its size is a power of two, kept at least
+    /// twice the size of `data`. Empty until `indexThreshold` is exceeded.
+    std::vector<std::uint32_t> index;
+
+    /// @brief Returns the slot of `index` holding `mKey`, or the empty
+    /// slot where it would be inserted.
+    inline auto findSlot(const TK& mKey) const noexcept
+    {
+        const auto mask(index.size() - 1);
+        auto s(THash{}(mKey) & mask);
+
+        while(index[s] != 0 && !(data[index[s] - 1].first == mKey))
+            s = (s + 1) & mask;
+
+        return s;
+    }
+
+    /// @brief Rebuilds `index` to fit at least `mCount` items.
+    inline void rebuildIndex(std::size_t mCount)
+    {
+        std::size_t size{indexThreshold * 4};
+        while(size < mCount * 2) size *= 2;
+
+        index.assign(size, 0);
+        for(auto i(0u); i < data.size(); ++i)
+            index[findSlot(data[i].first)] = std::uint32_t(i + 1);
+    }
+
+    /// @brief Returns the index in `data` of `mKey`, or the size of
+    /// `data` if unexistant.
+    inline std::size_t lookup(const TK& mKey) const noexcept
+    {
+        if(!index.empty())
+        {
+            const auto i(index[findSlot(mKey)]);
+            return i == 0 ? data.size() : i - 1;
+        }
+
+        for(auto i(0u); i < data.size(); ++i)
+            if(data[i].first == mKey) return i;
+
+        return data.size();
+    }
+
+    /// @brief Appends a new item with key `mKey`, which must be
+    /// unexistant.
+    template <typename TTK>
+    inline auto& append(TTK&& mKey)
+    {
+        auto& result(data.emplace_back(FWD(mKey), TV{}));
+
+        if(!index.empty())
+        {
+            if(data.size() * 2 > index.size())
+                rebuildIndex(data.size());
+            else
+                index[findSlot(result.first)] = std::uint32_t(data.size());
+        }
+        else if(data.size() > indexThreshold)
+            rebuildIndex(data.size());
+
+        return result.second;
+    }
+
+    template <typename TTK>
+    inline auto& getOrAppend(TTK&& mKey)
+    {
+        const auto i(lookup(mKey));
+        return i != data.size() ? data[i].second : append(FWD(mKey));
+    }
+
+public:
+    inline VecHashMap() = default;
+    inline VecHashMap(std::initializer_list<Item> mIL)
+    {
+        reserve(mIL.size());
+        for(const auto& p : mIL) getOrAppend(p.first) = p.second;
+    }
+
+    inline std::size_t count(const TK& mKey) const noexcept
+    {
+        return lookup(mKey) != data.size() ? 1 : 0;
+    }
+
+    /// @brief Returns whether or not `mKey` is present in the container.
+    inline bool has(const TK& mKey) const noexcept
+    {
+        return count(mKey) != 0;
+    }
+
+    /// @brief Returns a non-const reference to the value with key `mKey`.
+    /// The key/value pair is created if unexistant.
+    inline auto& operator[](const TK& mKey)
+    {
+        return getOrAppend(mKey);
+    }
+    inline auto& operator[](TK&& mKey)
+    {
+        return getOrAppend(std::move(mKey));
+    }
+
+    /// @brief Removes the key/value pair with key `mKey`, if existant,
+    /// preserving the order of the others. Returns the number of removed
+    /// pairs.
+    inline std::size_t erase(const TK& mKey)
+    {
+        const auto i(lookup(mKey));
+        if(i == data.size()) return 0;
+
+        data.erase(std::begin(data) + i);
+        if(!index.empty()) rebuildIndex(data.size());
+
+        return 1;
+    }
+
+    /// @brief Returns a const reference to the value with key `mKey`. An
+    /// exception is thrown if unexistant.
+    inline const auto& at(const TK& mKey) const
+    {
+        const auto i(lookup(mKey));
+        if(i != data.size()) return data[i].second;
+
+        throw std::out_of_range{""};
+    }
+
+    /// @brief Returns a const reference to the value with key `mKey`. A
+    /// default-constructed static `TV` is returned if unexistant.
+    inline const auto& atOrDefault(const TK& mKey) const noexcept
+    {
+        static TV defValue;
+
+        const auto i(lookup(mKey));
+        if(i != data.size()) return data[i].second;
+        return defValue;
+    }
+
+    /// @brief Returns an iterator to the value with key `mKey`. A
+    /// past-the-end iterator is returned if unexistant.
+    inline auto atItr(const TK& mKey) const noexcept
+    {
+        return std::begin(data) + lookup(mKey);
+    }
+
+    /// @brief Returns the internal vector storage, in insertion order.
+    inline const auto& getData() const noexcept
+    {
+        return data;
+    }
+
+    // Standard (partial) vector interface support
+    inline void reserve(std::size_t mV)
+    {
+        data.reserve(mV);
+        if(mV > indexThreshold && mV * 2 > index.size()) rebuildIndex(mV);
+    }
+    inline void clear() noexcept
+    {
+        data.clear();
+        index.clear();
+    }
+    inline auto size() const noexcept
+    {
+        return data.size();
+    }
+    inline auto empty() const noexcept
+    {
+        return data.empty();
+    }
+    inline auto capacity() const noexcept
+    {
+        return data.capacity();
+    }
+
+    // Standard iterator support
+    inline auto begin() noexcept
+    {
+        return std::begin(data);
+    }
+    inline auto end() noexcept
+    {
+        return std::end(data);
+    }
+    inline auto begin() const noexcept
+    {
+        return std::begin(data);
+    }
+    inline auto end() const noexcept
+    {
+        return std::end(data);
+    }
+    inline auto cbegin() const noexcept
+    {
+        return std::cbegin(data);
+    }
+    inline auto cend() const noexcept
+    {
+        return std::cend(data);
+    }
+    inline auto rbegin() noexcept
+    {
+        return std::rbegin(data);
+    }
+    inline auto rend() noexcept
+    {
+        return std::rend(data);
+    }
+    inline auto crbegin() const noexcept
+    {
+        return std::crbegin(data);
+    }
+    inline auto crend() const noexcept
+    {
+        return std::crend(data);
+    }
+
+    // Equality/inequality, regardless of insertion order
+    inline bool operator==(const VecHashMap& mVM) const noexcept
+    {
+        if(data.size() != mVM.data.size()) return false;
+
+        for(const auto& p : data)
+        {
+            const auto i(mVM.lookup(p.first));
+            if(i == mVM.data.size() || !(mVM.data[i].second == p.second))
+                return false;
+        }
+
+        return true;
+    }
+    inline bool operator!=(const VecHashMap& mVM) const noexcept
+    {
+        return !(operator==(mVM));
+    }
+};
+} // namespace ssvu
+
+#endif
@@ -95,6 +95,17 @@ public:
                              : data.emplace(itr, FWD(mKey), TV{})->second;
     }
 
+    /// @brief Removes the key/value pair with key `mKey`, if existant.
+    /// Returns the number of removed pairs.
+    inline std::size_t erase(const TK& mKey)
+    {
+        const auto itr(lookup(mKey));
+        if(!is(itr, mKey)) return 0;
+
+        data.erase(itr);
+        return 1;
+    }
+
     /// @brief Returns a const reference to the value with key `mKey`. An
     /// exception is thrown if unexistant.
     inline const auto& at(const TK& mKey) const
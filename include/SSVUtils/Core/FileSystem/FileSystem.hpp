@@ -10,6 +10,7 @@
 #include "SSVUtils/Core/FileSystem/Path.hpp"
 #include "SSVUtils/Core/FileSystem/Utils.hpp"
 #include "SSVUtils/Core/FileSystem/Scan.hpp"
+#include "SSVUtils/Core/FileSystem/MappedFile.hpp"
 
 /// @brief `ssvufs` is a namespace alias for `ssvu::FileSystem`.
 namespace ssvufs = ssvu::FileSystem;
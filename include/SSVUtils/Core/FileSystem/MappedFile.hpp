@@ -0,0 +1,186 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_CORE_FILESYSTEM_MAPPEDFILE
+#define SSVU_CORE_FILESYSTEM_MAPPEDFILE
+
+#include "SSVUtils/Core/FileSystem/Path.hpp"
+
+#include "SSVUtils/Core/Detection/Detection.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#if defined(SSVU_OS_LINUX) || defined(SSVU_OS_MAC)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ssvu
+{
+namespace FileSystem
+{
+/// @brief Read-only view of a file's contents.
+/// @details On Linux and Mac the file is memory-mapped, so its pages are
+/// read lazily and never copied. On other platforms, or if mapping fails,
+/// the contents are read into an owned buffer. In both cases the viewed
+/// characters do not move when the object is moved.
+class MappedFile
+{
+private:
+    const char* data{nullptr};
+    std::size_t size{0};
+
+    /// @brief True if `data` points to a memory mapping.
+    bool mapped{false};
+
+    /// @brief Owned contents, used when the file is not mapped.
+    std::unique_ptr<char[]> buffer;
+
+#if defined(SSVU_OS_LINUX) || defined(SSVU_OS_MAC)
+    inline bool openMapped(const Path& mPath) noexcept
+    {
+        const auto fd(::open(mPath.getCStr(), O_RDONLY));
+        if(fd == -1) return false;
+
+        struct stat st;
+        if(::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        size = std::size_t(st.st_size);
+
+        // Empty files cannot be mapped, but have nothing to view anyway
+        if(size == 0)
+        {
+            ::close(fd);
+            return true;
+        }
+
+        auto p(::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+        ::close(fd);
+
+        if(p == MAP_FAILED)
+        {
+            size = 0;
+            return false;
+        }
+
+        // The contents are expected to be read front to back
+        ::madvise(p, size, MADV_SEQUENTIAL);
+
+        data = static_cast<const char*>(p);
+        mapped = true;
+        return true;
+    }
+#endif
+
+    inline bool openBuffered(const Path& mPath)
+    {
+        std::ifstream ifs{mPath.getCStr(), std::ios_base::binary};
+        if(!ifs) return false;
+
+        ifs.seekg(0, std::ios::end);
+        size = std::size_t(ifs.tellg());
+        ifs.seekg(0);
+
+        buffer.reset(new char[size]);
+        ifs.read(buffer.get(), size);
+
+        data = buffer.get();
+        return true;
+    }
+
+    inline void moveFrom(MappedFile& mF) noexcept
+    {
+        data = std::exchange(mF.data, nullptr);
+        size = std::exchange(mF.size, 0);
+        mapped = std::exchange(mF.mapped, false);
+        buffer = std::move(mF.buffer);
+    }
+
+public:
+    inline MappedFile() noexcept = default;
+
+    /// @brief Opens the file in `mPath`. See `open`.
+    inline explicit MappedFile(const Path& mPath)
+    {
+        open(mPath);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    inline MappedFile(MappedFile&& mF) noexcept
+    {
+        moveFrom(mF);
+    }
+    inline MappedFile& operator=(MappedFile&& mF) noexcept
+    {
+        close();
+        moveFrom(mF);
+        return *this;
+    }
+
+    inline ~MappedFile() noexcept
+    {
+        close();
+    }
+
+    /// @brief Opens the file in `mPath`, closing the current one.
+    /// @details Returns false if the file could not be read, leaving the
+    /// view empty.
+    inline bool open(const Path& mPath)
+    {
+        close();
+
+#if defined(SSVU_OS_LINUX) || defined(SSVU_OS_MAC)
+        if(openMapped(mPath)) return true;
+#endif
+
+        return openBuffered(mPath);
+    }
+
+    /// @brief Releases the mapping or the buffer, emptying the view.
+    inline void close() noexcept
+    {
+#if defined(SSVU_OS_LINUX) || defined(SSVU_OS_MAC)
+        if(mapped) ::munmap(const_cast<char*>(data), size);
+#endif
+
+        data = nullptr;
+        size = 0;
+        mapped = false;
+        buffer.reset();
+    }
+
+    /// @brief Returns a view of the file's contents.
+    inline std::string_view getView() const noexcept
+    {
+        return {data, size};
+    }
+
+    /// @brief Returns true if the contents are memory-mapped.
+    inline bool isMapped() const noexcept
+    {
+        return mapped;
+    }
+
+    inline auto getSize() const noexcept
+    {
+        return size;
+    }
+};
+} // namespace FileSystem
+} // namespace ssvu
+
+#endif
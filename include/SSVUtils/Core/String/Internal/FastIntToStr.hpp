@@ -12,6 +12,7 @@
 #include <string>
 #include <cstring>
 #include <array>
+#include <limits>
 
 
 namespace ssvu
@@ -45,7 +46,9 @@ constexpr char digits[201]{
 template <typename T>
 struct Conv<T, std::enable_if_t<!std::is_unsigned_v<T>>>
 {
-    static constexpr std::size_t bufferSize{std::numeric_limits<T>::digits10};
+    // Room for all the digits, the sign and a leading padding digit
+    static constexpr std::size_t bufferSize{
+        std::numeric_limits<T>::digits10 + 3};
 
     inline static auto toStr(T val) noexcept
     {
@@ -92,7 +95,9 @@ struct Conv<T, std::enable_if_t<!std::is_unsigned_v<T>>>
 template <typename T>
 struct Conv<T, std::enable_if_t<std::is_unsigned_v<T>>>
 {
-    static constexpr std::size_t bufferSize{std::numeric_limits<T>::digits10};
+    // Room for all the digits, the sign and a leading padding digit
+    static constexpr std::size_t bufferSize{
+        std::numeric_limits<T>::digits10 + 3};
 
     inline static auto toStr(T val) noexcept
     {
@@ -0,0 +1,421 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Grisu2 algorithm from:
+// "Printing Floating-Point Numbers Quickly and Accurately with Integers"
+// By: Florian Loitsch
+
+#ifndef SSVU_CORE_STRING_INTERNAL_FASTREALTOSTR
+#define SSVU_CORE_STRING_INTERNAL_FASTREALTOSTR
+
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace ssvu
+{
+namespace Impl
+{
+namespace FastRealToStr
+{
+static_assert(std::numeric_limits<double>::is_iec559 &&
+                  sizeof(double) == sizeof(std::uint64_t),
+    "`double` must be an IEEE 754 binary64 floating point type");
+
+/// @brief Size of the buffers passed to `toChars`.
+constexpr std::size_t bufferSize{32};
+
+/// @brief Floating point number `f * 2^e` with a 64-bit significand.
+struct DiyFp
+{
+    std::uint64_t f;
+    int e;
+
+    inline static DiyFp sub(const DiyFp& mX, const DiyFp& mY) noexcept
+    {
+        return {mX.f - mY.f, mX.e};
+    }
+
+    /// @brief Returns `mX * mY`, rounded to 64 bits.
+    inline static DiyFp mul(const DiyFp& mX, const DiyFp& mY) noexcept
+    {
+        const std::uint64_t xLo{mX.f & 0xFFFFFFFFu}, xHi{mX.f >> 32};
+        const std::uint64_t yLo{mY.f & 0xFFFFFFFFu}, yHi{mY.f >> 32};
+
+        const auto ll(xLo * yLo), lh(xLo * yHi), hl(xHi * yLo), hh(xHi * yHi);
+        auto mid((ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu));
+
+        // Round to nearest
+        mid += std::uint64_t(1) << 31;
+
+        return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32), mX.e + mY.e + 64};
+    }
+
+    inline static DiyFp normalize(DiyFp mX) noexcept
+    {
+        while((mX.f >> 63) == 0)
+        {
+            mX.f <<= 1;
+            --mX.e;
+        }
+
+        return mX;
+    }
+
+    inline static DiyFp normalizeTo(const DiyFp& mX, int mE) noexcept
+    {
+        return {mX.f << (mX.e - mE), mE};
+    }
+};
+
+/// @brief Normalized value `w` of a double and its rounding boundaries
+/// `minus` and `plus`, with the same exponent.
+struct Boundaries
+{
+    DiyFp w, minus, plus;
+};
+
+inline Boundaries getBoundaries(double mX) noexcept
+{
+    constexpr int bias{1023 + 52};
+    constexpr std::uint64_t hiddenBit{std::uint64_t(1) << 52};
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &mX, sizeof(bits));
+
+    const auto exp(int(bits >> 52));
+    const auto frac(bits & (hiddenBit - 1));
+
+    const DiyFp v{exp == 0 ? DiyFp{frac, 1 - bias}
+                           : DiyFp{frac + hiddenBit, exp - bias}};
+
+    // The lower boundary is closer if the significand is a power of two
+    const auto lowerCloser(frac == 0 && exp > 1);
+
+    const DiyFp plus{2 * v.f + 1, v.e - 1};
+    const DiyFp minus{lowerCloser ? DiyFp{4 * v.f - 1, v.e - 2}
+                                  : DiyFp{2 * v.f - 1, v.e - 1}};
+
+    const auto wPlus(DiyFp::normalize(plus));
+    return {DiyFp::normalize(v), DiyFp::normalizeTo(minus, wPlus.e), wPlus};
+}
+
+/// @brief Normalized approximation of `10^k`.
+struct CachedPow
+{
+    std::uint64_t f;
+    int e, k;
+};
+
+/// @brief Minimum binary exponent of the scaled boundaries. The maximum
+/// one is `-32`.
+constexpr int targetMinExp{-60};
+
+constexpr int cachedPowsMinK{-300}, cachedPowsStepK{8};
+
+constexpr CachedPow cachedPows[]{
+    {0xab70fe17c79ac6cau, -1060, -300},
+    {0xff77b1fcbebcdc4fu, -1034, -292},
+    {0xbe5691ef416bd60cu, -1007, -284},
+    {0x8dd01fad907ffc3cu, -980, -276},
+    {0xd3515c2831559a83u, -954, -268},
+    {0x9d71ac8fada6c9b5u, -927, -260},
+    {0xea9c227723ee8bcbu, -901, -252},
+    {0xaecc49914078536du, -874, -244},
+    {0x823c12795db6ce57u, -847, -236},
+    {0xc21094364dfb5637u, -821, -228},
+    {0x9096ea6f3848984fu, -794, -220},
+    {0xd77485cb25823ac7u, -768, -212},
+    {0xa086cfcd97bf97f4u, -741, -204},
+    {0xef340a98172aace5u, -715, -196},
+    {0xb23867fb2a35b28eu, -688, -188},
+    {0x84c8d4dfd2c63f3bu, -661, -180},
+    {0xc5dd44271ad3cdbau, -635, -172},
+    {0x936b9fcebb25c996u, -608, -164},
+    {0xdbac6c247d62a584u, -582, -156},
+    {0xa3ab66580d5fdaf6u, -555, -148},
+    {0xf3e2f893dec3f126u, -529, -140},
+    {0xb5b5ada8aaff80b8u, -502, -132},
+    {0x87625f056c7c4a8bu, -475, -124},
+    {0xc9bcff6034c13053u, -449, -116},
+    {0x964e858c91ba2655u, -422, -108},
+    {0xdff9772470297ebdu, -396, -100},
+    {0xa6dfbd9fb8e5b88fu, -369, -92},
+    {0xf8a95fcf88747d94u, -343, -84},
+    {0xb94470938fa89bcfu, -316, -76},
+    {0x8a08f0f8bf0f156bu, -289, -68},
+    {0xcdb02555653131b6u, -263, -60},
+    {0x993fe2c6d07b7facu, -236, -52},
+    {0xe45c10c42a2b3b06u, -210, -44},
+    {0xaa242499697392d3u, -183, -36},
+    {0xfd87b5f28300ca0eu, -157, -28},
+    {0xbce5086492111aebu, -130, -20},
+    {0x8cbccc096f5088ccu, -103, -12},
+    {0xd1b71758e219652cu, -77, -4},
+    {0x9c40000000000000u, -50, 4},
+    {0xe8d4a51000000000u, -24, 12},
+    {0xad78ebc5ac620000u, 3, 20},
+    {0x813f3978f8940984u, 30, 28},
+    {0xc097ce7bc90715b3u, 56, 36},
+    {0x8f7e32ce7bea5c70u, 83, 44},
+    {0xd5d238a4abe98068u, 109, 52},
+    {0x9f4f2726179a2245u, 136, 60},
+    {0xed63a231d4c4fb27u, 162, 68},
+    {0xb0de65388cc8ada8u, 189, 76},
+    {0x83c7088e1aab65dbu, 216, 84},
+    {0xc45d1df942711d9au, 242, 92},
+    {0x924d692ca61be758u, 269, 100},
+    {0xda01ee641a708deau, 295, 108},
+    {0xa26da3999aef774au, 322, 116},
+    {0xf209787bb47d6b85u, 348, 124},
+    {0xb454e4a179dd1877u, 375, 132},
+    {0x865b86925b9bc5c2u, 402, 140},
+    {0xc83553c5c8965d3du, 428, 148},
+    {0x952ab45cfa97a0b3u, 455, 156},
+    {0xde469fbd99a05fe3u, 481, 164},
+    {0xa59bc234db398c25u, 508, 172},
+    {0xf6c69a72a3989f5cu, 534, 180},
+    {0xb7dcbf5354e9beceu, 561, 188},
+    {0x88fcf317f22241e2u, 588, 196},
+    {0xcc20ce9bd35c78a5u, 614, 204},
+    {0x98165af37b2153dfu, 641, 212},
+    {0xe2a0b5dc971f303au, 667, 220},
+    {0xa8d9d1535ce3b396u, 694, 228},
+    {0xfb9b7cd9a4a7443cu, 720, 236},
+    {0xbb764c4ca7a44410u, 747, 244},
+    {0x8bab8eefb6409c1au, 774, 252},
+    {0xd01fef10a657842cu, 800, 260},
+    {0x9b10a4e5e9913129u, 827, 268},
+    {0xe7109bfba19c0c9du, 853, 276},
+    {0xac2820d9623bf429u, 880, 284},
+    {0x80444b5e7aa7cf85u, 907, 292},
+    {0xbf21e44003acdd2du, 933, 300},
+    {0x8e679c2f5e44ff8fu, 960, 308},
+    {0xd433179d9c8cb841u, 986, 316},
+    {0x9e19db92b4e31ba9u, 1013, 324},
+    {0xeb96bf6ebadf77d9u, 1039, 332},
+    {0xaf87023b9bf0ee6bu, 1066, 340}};
+
+/// @brief Returns a cached power `c` such that `c.e + mE + 64` is in
+/// `[-60, -32]`.
+inline const CachedPow& getCachedPow(int mE) noexcept
+{
+    const auto f(targetMinExp - mE - 1);
+    const auto k((f * 78913) / (1 << 18) + (f > 0));
+    const auto idx(
+        (-cachedPowsMinK + k + (cachedPowsStepK - 1)) / cachedPowsStepK);
+
+    return cachedPows[idx];
+}
+
+/// @brief Returns the number of decimal digits of `mN`, storing the
+/// largest power of ten not greater than `mN` in `mPow10`.
+inline int getDigitCount(std::uint32_t mN, std::uint32_t& mPow10) noexcept
+{
+    constexpr std::uint32_t pows10[]{1, 10, 100, 1000, 10000, 100000,
+        1000000, 10000000, 100000000, 1000000000};
+
+    auto result(10);
+    while(result > 1 && mN < pows10[result - 1]) --result;
+
+    mPow10 = pows10[result - 1];
+    return result;
+}
+
+/// @brief Moves the last digit of `mBuf` closer to the exact value, while
+/// staying inside the rounding boundaries.
+inline void roundWeed(char* mBuf, int mLen, std::uint64_t mDist,
+    std::uint64_t mDelta, std::uint64_t mRest, std::uint64_t mTenK) noexcept
+{
+    while(mRest < mDist && mDelta - mRest >= mTenK &&
+          (mRest + mTenK < mDist || mDist - mRest > mRest + mTenK - mDist))
+    {
+        --mBuf[mLen - 1];
+        mRest += mTenK;
+    }
+}
+
+/// @brief Generates the shortest digits of a number in `(mMinus, mPlus)`,
+/// as close as possible to `mW`.
+inline void genDigits(char* mBuf, int& mLen, int& mDecExp, DiyFp mMinus,
+    DiyFp mW, DiyFp mPlus) noexcept
+{
+    auto delta(DiyFp::sub(mPlus, mMinus).f);
+    auto dist(DiyFp::sub(mPlus, mW).f);
+
+    const DiyFp one{std::uint64_t(1) << -mPlus.e, mPlus.e};
+
+    // Integral and fractional parts of `mPlus`
+    auto p1(std::uint32_t(mPlus.f >> -one.e));
+    auto p2(mPlus.f & (one.f - 1));
+
+    std::uint32_t pow10;
+    for(auto n(getDigitCount(p1, pow10)); n > 0;)
+    {
+        mBuf[mLen++] = char('0' + p1 / pow10);
+        p1 %= pow10;
+        --n;
+
+        const auto rest((std::uint64_t(p1) << -one.e) + p2);
+        if(rest <= delta)
+        {
+            mDecExp += n;
+            roundWeed(mBuf, mLen, dist, delta, rest,
+                std::uint64_t(pow10) << -one.e);
+            return;
+        }
+
+        pow10 /= 10;
+    }
+
+    auto m(0);
+    while(true)
+    {
+        p2 *= 10;
+        mBuf[mLen++] = char('0' + (p2 >> -one.e));
+        p2 &= one.f - 1;
+        ++m;
+
+        delta *= 10;
+        dist *= 10;
+        if(p2 <= delta) break;
+    }
+
+    mDecExp -= m;
+    roundWeed(mBuf, mLen, dist, delta, p2, one.f);
+}
+
+/// @brief Writes the shortest digits of the positive finite `mX` to
+/// `mBuf`, so that `mX == digits * 10^mDecExp`.
+inline void grisu2(char* mBuf, int& mLen, int& mDecExp, double mX) noexcept
+{
+    const auto b(getBoundaries(mX));
+    const auto& c(getCachedPow(b.plus.e));
+    const DiyFp cK{c.f, c.e};
+
+    const auto w(DiyFp::mul(b.w, cK));
+    const auto wMinus(DiyFp::mul(b.minus, cK));
+    const auto wPlus(DiyFp::mul(b.plus, cK));
+
+    // Shrink the interval to account for the rounding errors of `mul`
+    mLen = 0;
+    mDecExp = -c.k;
+    genDigits(mBuf, mLen, mDecExp, {wMinus.f + 1, wMinus.e}, w,
+        {wPlus.f - 1, wPlus.e});
+}
+
+inline char* writeExponent(char* mBuf, int mE) noexcept
+{
+    *mBuf++ = mE < 0 ? '-' : '+';
+    if(mE < 0) mE = -mE;
+
+    if(mE >= 100)
+    {
+        *mBuf++ = char('0' + mE / 100);
+        mE %= 100;
+        *mBuf++ = char('0' + mE / 10);
+    }
+    else if(mE >= 10)
+        *mBuf++ = char('0' + mE / 10);
+
+    *mBuf++ = char('0' + mE % 10);
+    return mBuf;
+}
+
+/// @brief Formats the `mLen` digits in `mBuf`, multiplied by `10^mDecExp`,
+/// in fixed or scientific notation. Returns the end of the result.
+inline char* formatDigits(char* mBuf, int mLen, int mDecExp,
+    bool mForceDecimal) noexcept
+{
+    constexpr int minExp{-4}, maxExp{15};
+
+    // Position of the decimal point relative to the first digit
+    const auto n(mLen + mDecExp);
+
+    if(mLen <= n && n <= maxExp)
+    {
+        // Integral value: digits[000][.0]
+        std::memset(mBuf + mLen, '0', n - mLen);
+        if(!mForceDecimal) return mBuf + n;
+
+        mBuf[n] = '.';
+        mBuf[n + 1] = '0';
+        return mBuf + n + 2;
+    }
+
+    if(0 < n && n <= maxExp)
+    {
+        // dig.its
+        std::memmove(mBuf + n + 1, mBuf + n, mLen - n);
+        mBuf[n] = '.';
+        return mBuf + mLen + 1;
+    }
+
+    if(minExp < n && n <= 0)
+    {
+        // 0.[000]digits
+        std::memmove(mBuf + 2 - n, mBuf, mLen);
+        mBuf[0] = '0';
+        mBuf[1] = '.';
+        std::memset(mBuf + 2, '0', -n);
+        return mBuf + 2 - n + mLen;
+    }
+
+    // d[.igits]e+123
+    if(mLen > 1)
+    {
+        std::memmove(mBuf + 2, mBuf + 1, mLen - 1);
+        mBuf[1] = '.';
+        ++mLen;
+    }
+
+    mBuf[mLen] = 'e';
+    return writeExponent(mBuf + mLen + 1, n - 1);
+}
+
+/// @brief Writes the shortest representation of `mX` that reads back to
+/// the same value to `mBuf`, which must have room for `bufferSize`
+/// characters. Returns the end of the result.
+/// @details If `mForceDecimal` is true, integral values in fixed notation
+/// are written with a trailing `.0`.
+inline char* toChars(char* mBuf, double mX, bool mForceDecimal) noexcept
+{
+    if(std::signbit(mX))
+    {
+        *mBuf++ = '-';
+        mX = -mX;
+    }
+
+    if(!std::isfinite(mX))
+    {
+        std::memcpy(mBuf, std::isnan(mX) ? "nan" : "inf", 3);
+        return mBuf + 3;
+    }
+
+    if(mX == 0)
+    {
+        *mBuf++ = '0';
+        if(!mForceDecimal) return mBuf;
+
+        std::memcpy(mBuf, ".0", 2);
+        return mBuf + 2;
+    }
+
+    int len, decExp;
+    grisu2(mBuf, len, decExp, mX);
+    return formatDigits(mBuf, len, decExp, mForceDecimal);
+}
+
+inline auto toStr(double mX)
+{
+    char buf[bufferSize];
+    return std::string(buf, toChars(buf, mX, false));
+}
+} // namespace FastRealToStr
+} // namespace Impl
+} // namespace ssvu
+
+#endif
@@ -6,6 +6,7 @@
 #define SSVU_CORE_STRING_TOSTR
 
 #include "SSVUtils/Core/String/Internal/FastIntToStr.hpp"
+#include "SSVUtils/Core/String/Internal/FastRealToStr.hpp"
 #include "SSVUtils/Core/String/StringifierBase.hpp"
 #include "SSVUtils/Core/Stringifier/Stringifier.hpp"
 #include "SSVUtils/Core/ConsoleFmt/ConsoleFmt.hpp"
@@ -51,6 +52,15 @@ SSVU_IMPL_FASTINTTOSTR_CONV(unsigned long)
 SSVU_IMPL_FASTINTTOSTR_CONV(unsigned long long)
 
 #undef SSVU_IMPL_FASTINTTOSTR_CONV
+
+template <>
+struct ToStrImpl<double>
+{
+    inline static auto toStr(const double& mX)
+    {
+        return Impl::FastRealToStr::toStr(mX);
+    }
+};
 } // namespace Impl
 
 /// @brief Converts a value to a string.
@@ -8,6 +8,7 @@
 #include "SSVUtils/Container/Container.hpp"
 
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ssvu
@@ -40,8 +41,11 @@ namespace Impl
 {
 /// @typedef Template for `Obj` type. Intended to be instantiated
 /// with `Val`.
-template <typename T>
-using ObjImpl = VecMap<Key, T>;
+/// @details Objects are sorted by key, unless `THashed` is true: they are
+/// then kept in insertion order, with a hash index for wide objects.
+template <typename T, bool THashed = false>
+using ObjImpl =
+    std::conditional_t<THashed, VecHashMap<Key, T>, VecMap<Key, T>>;
 
 /// @typedef Template for `Arr` type. Intended to be instantiated
 /// with `Val`.
@@ -82,12 +86,52 @@ using WSPrettyLog = WriterSettings<true, true>;
 
 
 /// @brief Struct holding settings for `Reader`.
+/// @tparam TInSitu If true, parses directly from a caller-owned buffer,
+/// skipping whitespace and comments on the fly instead of copying and
+/// purging the source first.
+/// @tparam TIndexed If true, indexes token positions with vector
+/// instructions a window ahead of the parser, which then jumps between
+/// them. Requires `TInSitu`.
+/// @tparam TNumArrs If true, arrays of at least `Val::numArrThreshold`
+/// numbers, all read as `IntS` or all read as `Real`, are stored as
+/// contiguous numeric arrays.
+template <bool TInSitu, bool TIndexed = false, bool TNumArrs = false>
 struct ReaderSettings
 {
+    enum
+    {
+        inSitu = TInSitu,
+        indexed = TIndexed,
+        numArrs = TNumArrs
+    };
 };
 
 /// @typedef `Reader` settings intended for any JSON file.
-using RSDefault = ReaderSettings;
+using RSDefault = ReaderSettings<false>;
+
+/// @typedef `Reader` settings intended for large JSON sources that outlive
+/// the parsing process.
+/// @details The source is never copied: it must stay alive until parsing is
+/// done.
+using RSInSitu = ReaderSettings<true>;
+
+/// @typedef `Reader` settings intended for large standard JSON sources that
+/// outlive the parsing process.
+/// @details Reads tokens from an index of the source, built a few
+/// kilobytes ahead of the parser. Building the index has a cost of its own,
+/// which only pays off when tokens are far apart: in `JsonBenchmark`, SAX
+/// reading of a source with long strings is about 2.4 times faster than
+/// with `RSInSitu`, while reading a source of short tokens into a `Val` is
+/// about 20% slower. Prefer `RSInSitu` unless most of the source is made
+/// of long strings. Falls back to `RSInSitu` behavior from the first part
+/// of the source containing comments.
+using RSIndexed = ReaderSettings<true, true>;
+
+/// @typedef `Reader` settings intended for large sources of numeric data,
+/// such as vertex buffers or time series, that outlive the parsing process.
+/// @details Homogeneous arrays of numbers are stored contiguously: see
+/// `Val::isNumArr`.
+using RSInSituNumArrs = ReaderSettings<true, false, true>;
 } // namespace Json
 } // namespace ssvu
 
@@ -0,0 +1,496 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_DOC_DOCUMENT
+#define SSVU_JSON_DOC_DOCUMENT
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Range/Range.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Num/Num.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/Io.hpp"
+#include "SSVUtils/Json/Doc/Internal/Arena.hpp"
+#include "SSVUtils/Json/Doc/Internal/DocNode.hpp"
+#include "SSVUtils/Json/Doc/Internal/DocBuilder.hpp"
+#include "SSVUtils/Json/Doc/KeyTable.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+class Document;
+
+/// @brief Read-only handle to a value of a `Document`.
+/// @details Cheap to copy. Valid as long as the document is neither
+/// destroyed nor moved.
+class DocVal
+{
+    friend class Document;
+
+private:
+    const Document* doc;
+    const Impl::DocNode* node;
+
+    inline DocVal(const Document& mDoc, const Impl::DocNode* mNode) noexcept
+        : doc{&mDoc}, node{mNode}
+    {
+    }
+
+    inline const Impl::DocNode& getNode() const noexcept
+    {
+        return *node;
+    }
+
+    /// @brief Returns the value with key `mKey`, or the null node.
+    inline const Impl::DocNode* find(std::string_view mKey) const;
+
+public:
+    /// @brief Iterator over the elements of an array.
+    class ArrItr
+    {
+    private:
+        const Document* doc;
+        const Impl::DocNode* node;
+
+    public:
+        inline ArrItr(
+            const Document& mDoc, const Impl::DocNode* mNode) noexcept
+            : doc{&mDoc}, node{mNode}
+        {
+        }
+
+        inline DocVal operator*() const noexcept
+        {
+            return {*doc, node};
+        }
+        inline ArrItr& operator++() noexcept
+        {
+            ++node;
+            return *this;
+        }
+        inline bool operator==(const ArrItr& mI) const noexcept
+        {
+            return node == mI.node;
+        }
+        inline bool operator!=(const ArrItr& mI) const noexcept
+        {
+            return node != mI.node;
+        }
+    };
+
+    /// @brief Iterator over the key-value pairs of an object.
+    class ObjItr
+    {
+    private:
+        const Document* doc;
+        const Impl::DocNode* node;
+
+    public:
+        inline ObjItr(
+            const Document& mDoc, const Impl::DocNode* mNode) noexcept
+            : doc{&mDoc}, node{mNode}
+        {
+        }
+
+        inline std::pair<std::string_view, DocVal> operator*() const
+        {
+            return {DocVal{*doc, node}.as<std::string_view>(),
+                DocVal{*doc, node + 1}};
+        }
+        inline ObjItr& operator++() noexcept
+        {
+            node += 2;
+            return *this;
+        }
+        inline bool operator==(const ObjItr& mI) const noexcept
+        {
+            return node == mI.node;
+        }
+        inline bool operator!=(const ObjItr& mI) const noexcept
+        {
+            return node != mI.node;
+        }
+    };
+
+    /// @brief Returns the type of the value.
+    inline auto getType() const noexcept
+    {
+        return getNode().type;
+    }
+
+    /// @brief Checks if the value is of type `T`.
+    /// @details `Obj`, `Arr`, `Nll`, `Bln` and `Num` check the value type.
+    /// `Str` and `std::string_view` check for strings. `IntS`, `IntU` and
+    /// `Real` also check the number representation; any other arithmetic
+    /// type only checks for numbers.
+    template <typename T>
+    inline bool is() const noexcept;
+
+    /// @brief Returns the value as `T`.
+    /// @details Strings can be retrieved as `std::string_view`, valid as
+    /// long as the document, or as `Str` copies. Arithmetic types are
+    /// converted from the stored number. `Val` returns a deep copy.
+    template <typename T>
+    inline T as() const;
+
+    /// @brief Returns a `Val` holding a deep copy of this value.
+    inline Val toVal() const;
+
+    /// @brief Returns the value with key `mKey`, or a null value if there
+    /// is no such key.
+    /// @details Must only be called on objects. Linear in the number of
+    /// keys. If the document interns its keys, keys obtained from its
+    /// `KeyTable` are compared by address only.
+    inline DocVal operator[](std::string_view mKey) const
+    {
+        return {*doc, find(mKey)};
+    }
+
+    /// @brief Returns the `mIdx`-th element, or a null value if there is
+    /// no such element.
+    /// @details Must only be called on arrays.
+    inline DocVal operator[](Idx mIdx) const noexcept
+    {
+        return {*doc, has(mIdx) ? getNode().children + mIdx
+                                : &Impl::getNllDocNode()};
+    }
+
+    /// @brief Returns true if this object has a value with key `mKey`.
+    inline bool has(std::string_view mKey) const
+    {
+        return find(mKey) != &Impl::getNllDocNode();
+    }
+
+    /// @brief Returns true if this array has an element with index `mIdx`.
+    inline bool has(Idx mIdx) const noexcept
+    {
+        return mIdx < getSizeArr();
+    }
+
+    /// @brief Returns the value with key `mKey` as `T` if existant,
+    /// otherwise `mDef`.
+    template <typename T>
+    inline T getIfHas(std::string_view mKey, const T& mDef) const
+    {
+        const auto n(find(mKey));
+        return n != &Impl::getNllDocNode() ? DocVal{*doc, n}.as<T>() : mDef;
+    }
+
+    // Size getters
+    inline Idx getSizeArr() const noexcept
+    {
+        assert(getType() == Val::Type::TArr);
+        return getNode().size;
+    }
+    inline Idx getSizeObj() const noexcept
+    {
+        assert(getType() == Val::Type::TObj);
+        return getNode().size;
+    }
+
+    // Empty tests
+    inline bool isEmptyArr() const noexcept
+    {
+        return getSizeArr() == 0;
+    }
+    inline bool isEmptyObj() const noexcept
+    {
+        return getSizeObj() == 0;
+    }
+
+    /// @brief Returns a range over the elements of this array.
+    inline auto forArr() const noexcept
+    {
+        assert(getType() == Val::Type::TArr);
+        const auto c(getNode().children);
+        return makeRange(ArrItr{*doc, c}, ArrItr{*doc, c + getSizeArr()});
+    }
+
+    /// @brief Returns a range over the key-value pairs of this object.
+    inline auto forObj() const noexcept
+    {
+        assert(getType() == Val::Type::TObj);
+        const auto c(getNode().children);
+        return makeRange(
+            ObjItr{*doc, c}, ObjItr{*doc, c + 2 * getSizeObj()});
+    }
+};
+
+/// @brief Read-only JSON document that does not copy its strings.
+/// @details String values are views into the source. All nodes, child
+/// arrays and unescaped strings live in a monotonic arena, which is freed
+/// in one step when the document is destroyed or read again. Strings
+/// containing escape sequences are unescaped on first access, so accessing
+/// the same document from multiple threads requires synchronization. When
+/// reading from a `std::string_view` or an lvalue string, the source must
+/// outlive the document; rvalue strings and mapped files are owned by the
+/// document.
+/// Object keys are views into the source as well, unless a `KeyTable` is
+/// passed to the constructor: keys are then interned in it, stored once no
+/// matter how many records repeat them, and can be looked up by address.
+/// The table can be shared by several documents with similar keys.
+class Document
+{
+    friend class DocVal;
+
+private:
+    /// @brief Source owned by the document, if any.
+    /// @details Heap-allocated so that moving the document does not move
+    /// the characters that nodes point to.
+    std::unique_ptr<std::string> ownedSrc;
+
+    /// @brief File viewed by the document, if any.
+    ssvufs::MappedFile ownedFile;
+
+    /// @brief Storage for nodes and unescaped strings.
+    mutable Impl::Arena arena;
+
+    /// @brief Stack of pending nodes, reused between reads.
+    std::vector<Impl::DocNode> pending;
+
+    /// @brief Unescaping buffer, reused between strings.
+    mutable std::string strBuf;
+
+    /// @brief Table interning the object keys, if any.
+    KeyTable* keys{nullptr};
+
+    const Impl::DocNode* root{&Impl::getNllDocNode()};
+
+    /// @brief Unescapes the string node `mNode`, if necessary.
+    inline const Impl::DocNode& getStrNode(const Impl::DocNode& mNode) const
+    {
+        if(SSVU_LIKELY(!mNode.escaped)) return mNode;
+
+        // Nodes are only ever handed out as const by the document, but live
+        // in its mutable arena
+        auto& n(const_cast<Impl::DocNode&>(mNode));
+
+        strBuf.clear();
+        Impl::unescapeStr(std::string_view{n.str, n.size}, strBuf);
+
+        n.str = arena.copyArr(strBuf.data(), strBuf.size());
+        n.size = std::uint32_t(strBuf.size());
+        n.escaped = false;
+        return n;
+    }
+
+    template <typename TRS>
+    inline bool parse(std::string_view mSrc)
+    {
+        static_assert(TRS::inSitu,
+            "`Document` requires in-situ reading settings, as its strings "
+            "point into the source");
+
+        arena.clear();
+        arena.reserve(mSrc.size());
+        pending.clear();
+
+        Impl::DocBuilder builder{arena, keys, pending};
+        Impl::Reader<TRS> r{mSrc};
+
+        const auto result(Impl::tryParseSax<TRS>(builder, r));
+        root = result ? builder.getRoot() : &Impl::getNllDocNode();
+        return result;
+    }
+
+public:
+    inline Document() = default;
+
+    /// @brief Constructs a document that interns its keys in `mKeys`,
+    /// which must outlive it.
+    inline explicit Document(KeyTable& mKeys) noexcept : keys{&mKeys}
+    {
+    }
+
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+
+    Document(Document&&) = default;
+    Document& operator=(Document&&) = default;
+
+    /// @brief Reads the document from `mSrc`, replacing its contents.
+    /// @details Returns `false` if a reading error occurred, leaving the
+    /// document null.
+    template <typename TRS = RSInSitu, typename T>
+    inline bool readFromStr(T&& mSrc)
+    {
+        if constexpr(std::is_same_v<std::decay_t<T>, std::string> &&
+                     !std::is_lvalue_reference_v<T>)
+        {
+            ownedSrc = std::make_unique<std::string>(std::move(mSrc));
+            ownedFile.close();
+            return parse<TRS>(*ownedSrc);
+        }
+        else
+        {
+            ownedSrc.reset();
+            ownedFile.close();
+            return parse<TRS>(std::string_view{mSrc});
+        }
+    }
+
+    /// @brief Reads the document from the file in `mPath`, replacing its
+    /// contents.
+    /// @details The file stays mapped for the lifetime of the document,
+    /// so its strings are never copied.
+    template <typename TRS = RSInSitu>
+    inline bool readFromFile(const ssvufs::Path& mPath)
+    {
+        ownedSrc.reset();
+        ownedFile.open(mPath);
+        return parse<TRS>(ownedFile.getView());
+    }
+
+    template <typename TRS = RSInSitu, typename T>
+    inline static Document fromStr(T&& mSrc)
+    {
+        Document result;
+        result.readFromStr<TRS>(FWD(mSrc));
+        return result;
+    }
+
+    template <typename TRS = RSInSitu>
+    inline static Document fromFile(const ssvufs::Path& mPath)
+    {
+        Document result;
+        result.readFromFile<TRS>(mPath);
+        return result;
+    }
+
+    /// @brief Returns the root value.
+    inline DocVal getRoot() const noexcept
+    {
+        return {*this, root};
+    }
+
+    // Root value shortcuts
+    inline auto operator[](std::string_view mKey) const
+    {
+        return getRoot()[mKey];
+    }
+    inline auto operator[](Idx mIdx) const noexcept
+    {
+        return getRoot()[mIdx];
+    }
+    inline auto getType() const noexcept
+    {
+        return getRoot().getType();
+    }
+    inline Val toVal() const
+    {
+        return getRoot().toVal();
+    }
+};
+
+inline const Impl::DocNode* DocVal::find(std::string_view mKey) const
+{
+    assert(getType() == Val::Type::TObj);
+
+    // Interned keys are matched by address alone
+    const auto c(getNode().children);
+    for(auto k(c); k != c + 2 * getSizeObj(); k += 2)
+    {
+        const auto& n(doc->getStrNode(*k));
+        if(n.str == mKey.data() ? n.size == mKey.size()
+                                : std::string_view{n.str, n.size} == mKey)
+            return k + 1;
+    }
+
+    return &Impl::getNllDocNode();
+}
+
+template <typename T>
+inline bool DocVal::is() const noexcept
+{
+    using Type = Val::Type;
+    const auto& n(getNode());
+
+    if constexpr(std::is_same_v<T, Impl::Obj>)
+        return n.type == Type::TObj;
+    else if constexpr(std::is_same_v<T, Impl::Arr>)
+        return n.type == Type::TArr;
+    else if constexpr(std::is_same_v<T, Str> ||
+                      std::is_same_v<T, std::string_view>)
+        return n.type == Type::TStr;
+    else if constexpr(std::is_same_v<T, Nll>)
+        return n.type == Type::TNll;
+    else if constexpr(std::is_same_v<T, Bln>)
+        return n.type == Type::TBln;
+    else if constexpr(std::is_same_v<T, Impl::Num>)
+        return n.type == Type::TNum;
+    else if constexpr(std::is_same_v<T, IntS>)
+        return n.type == Type::TNum && n.num.getRepr() == Impl::Num::Repr::IntS;
+    else if constexpr(std::is_same_v<T, IntU>)
+        return n.type == Type::TNum && n.num.getRepr() == Impl::Num::Repr::IntU;
+    else if constexpr(std::is_same_v<T, Real>)
+        return n.type == Type::TNum && n.num.getRepr() == Impl::Num::Repr::Real;
+    else
+    {
+        static_assert(std::is_arithmetic_v<T>, "Unsupported type");
+        return n.type == Type::TNum;
+    }
+}
+
+template <typename T>
+inline T DocVal::as() const
+{
+    if constexpr(std::is_same_v<T, std::string_view> ||
+                 std::is_same_v<T, Str>)
+    {
+        assert(getType() == Val::Type::TStr);
+        const auto& n(doc->getStrNode(getNode()));
+        return T(n.str, n.size);
+    }
+    else if constexpr(std::is_same_v<T, Val>)
+        return toVal();
+    else if constexpr(std::is_same_v<T, Nll>)
+    {
+        assert(getType() == Val::Type::TNll);
+        return Nll{};
+    }
+    else if constexpr(std::is_same_v<T, Bln>)
+    {
+        assert(getType() == Val::Type::TBln);
+        return getNode().bln;
+    }
+    else if constexpr(std::is_same_v<T, Impl::Num>)
+    {
+        assert(getType() == Val::Type::TNum);
+        return getNode().num;
+    }
+    else
+    {
+        static_assert(std::is_arithmetic_v<T>, "Unsupported type");
+        assert(getType() == Val::Type::TNum);
+        return getNode().num.template as<T>();
+    }
+}
+
+/// @brief Returns a document read from the string `mSrc`.
+template <typename TRS = RSInSitu, typename T>
+inline auto docFromStr(T&& mSrc)
+{
+    return Document::fromStr<TRS>(FWD(mSrc));
+}
+
+/// @brief Returns a document read from the file in `mPath`.
+template <typename TRS = RSInSitu>
+inline auto docFromFile(const ssvufs::Path& mPath)
+{
+    return Document::fromFile<TRS>(mPath);
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,54 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_DOC_DOCUMENT_INL
+#define SSVU_JSON_DOC_DOCUMENT_INL
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Doc/Document.hpp"
+
+namespace ssvu
+{
+namespace Json
+{
+inline Val DocVal::toVal() const
+{
+    Val result;
+
+    switch(getType())
+    {
+        case Val::Type::TObj:
+        {
+            result = Impl::Obj{};
+            auto& obj(result.as<Impl::Obj>());
+            obj.reserve(getSizeObj());
+
+            for(const auto& p : forObj())
+                obj[Str{p.first}] = p.second.toVal();
+
+            break;
+        }
+        case Val::Type::TArr:
+        {
+            result = Impl::Arr{};
+            auto& arr(result.as<Impl::Arr>());
+            arr.reserve(getSizeArr());
+
+            for(const auto& v : forArr()) arr.emplace_back(v.toVal());
+            break;
+        }
+        case Val::Type::TStr: result = as<Str>(); break;
+        case Val::Type::TNum: result = getNode().num; break;
+        case Val::Type::TBln: result = getNode().bln; break;
+        case Val::Type::TNll: break;
+    }
+
+    return result;
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
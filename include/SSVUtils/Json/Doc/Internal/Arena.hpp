@@ -0,0 +1,148 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_DOC_INTERNAL_ARENA
+#define SSVU_JSON_DOC_INTERNAL_ARENA
+
+#include "SSVUtils/Core/Core.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Monotonic allocator used by `Document`.
+/// @details Memory is carved out of growing blocks and is never released
+/// individually: all allocations are freed at once when the arena is
+/// cleared or destroyed. Only trivially destructible objects can be
+/// stored. Allocated memory does not move when the arena is moved.
+class Arena
+{
+private:
+    static constexpr std::size_t minBlockSize{4096};
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t lastBlockSize{0};
+    char* ptr{nullptr};
+    char* end{nullptr};
+
+    inline static char* alignUp(char* mP, std::size_t mAlign) noexcept
+    {
+        const auto p(reinterpret_cast<std::uintptr_t>(mP));
+        return mP + ((mAlign - p % mAlign) % mAlign);
+    }
+
+    inline void addBlock(std::size_t mMinSize)
+    {
+        lastBlockSize = std::max({mMinSize, minBlockSize, lastBlockSize * 2});
+        blocks.emplace_back(new char[lastBlockSize]);
+
+        ptr = blocks.back().get();
+        end = ptr + lastBlockSize;
+    }
+
+public:
+    inline Arena() noexcept = default;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    inline Arena(Arena&& mA) noexcept
+        : blocks{std::move(mA.blocks)}, lastBlockSize{mA.lastBlockSize},
+          ptr{mA.ptr}, end{mA.end}
+    {
+        mA.blocks.clear();
+        mA.lastBlockSize = 0;
+        mA.ptr = mA.end = nullptr;
+    }
+
+    inline Arena& operator=(Arena&& mA) noexcept
+    {
+        blocks = std::move(mA.blocks);
+        lastBlockSize = mA.lastBlockSize;
+        ptr = mA.ptr;
+        end = mA.end;
+
+        mA.blocks.clear();
+        mA.lastBlockSize = 0;
+        mA.ptr = mA.end = nullptr;
+        return *this;
+    }
+
+    /// @brief Returns `mBytes` bytes of uninitialized memory aligned to
+    /// `mAlign`, which must be a power of two.
+    inline void* allocate(std::size_t mBytes, std::size_t mAlign)
+    {
+        auto p(alignUp(ptr, mAlign));
+        if(SSVU_UNLIKELY(ptr == nullptr || mBytes > std::size_t(end - p)))
+        {
+            addBlock(mBytes + mAlign);
+            p = alignUp(ptr, mAlign);
+        }
+
+        ptr = p + mBytes;
+        return p;
+    }
+
+    /// @brief Returns uninitialized storage for `mCount` objects of type
+    /// `T`.
+    template <typename T>
+    inline T* allocArr(std::size_t mCount)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,
+            "Arena-allocated types must be trivially destructible");
+
+        return static_cast<T*>(allocate(sizeof(T) * mCount, alignof(T)));
+    }
+
+    /// @brief Copies `mCount` objects starting at `mSrc` in the arena.
+    template <typename T>
+    inline T* copyArr(const T* mSrc, std::size_t mCount)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "Arena-copied types must be trivially copyable");
+
+        auto result(allocArr<T>(mCount));
+        if(mCount > 0) std::memcpy(result, mSrc, sizeof(T) * mCount);
+        return result;
+    }
+
+    /// @brief Makes sure the next `mBytes` bytes of allocations fit in a
+    /// single block.
+    inline void reserve(std::size_t mBytes)
+    {
+        if(ptr == nullptr || std::size_t(end - ptr) < mBytes)
+            addBlock(mBytes);
+    }
+
+    /// @brief Frees all allocations at once.
+    /// @details The largest block is kept and reused.
+    inline void clear() noexcept
+    {
+        if(blocks.empty()) return;
+
+        std::swap(blocks.front(), blocks.back());
+        blocks.resize(1);
+
+        ptr = blocks.front().get();
+        end = ptr + lastBlockSize;
+    }
+};
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
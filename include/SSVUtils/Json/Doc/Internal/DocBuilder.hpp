@@ -0,0 +1,174 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_DOC_INTERNAL_DOCBUILDER
+#define SSVU_JSON_DOC_INTERNAL_DOCBUILDER
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Num/Num.hpp"
+#include "SSVUtils/Json/Doc/Internal/Arena.hpp"
+#include "SSVUtils/Json/Doc/Internal/DocNode.hpp"
+#include "SSVUtils/Json/Doc/KeyTable.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief SAX handler that builds the nodes of a `Document` in an arena.
+/// @details Nodes are first pushed on a stack; when a container ends, its
+/// children are moved to a contiguous arena array. Only receives raw
+/// strings, which are stored as views into the source without being
+/// unescaped. If a `KeyTable` is given, keys are unescaped and interned in
+/// it instead.
+class DocBuilder
+{
+private:
+    Arena& arena;
+    KeyTable* keys;
+
+    /// @brief Nodes whose container has not ended yet.
+    std::vector<DocNode>& nodes;
+
+    /// @brief Indices in `nodes` of the containers being filled.
+    std::vector<std::uint32_t> stack;
+
+    /// @brief Unescaping buffer for keys.
+    std::string keyBuf;
+
+    /// @brief Recently interned keys, indexed by `getRecentIdx`.
+    /// @details Records usually repeat the same few keys: most of them are
+    /// found here without being hashed.
+    std::array<std::string_view, 64> recent{};
+
+    inline static auto getRecentIdx(std::string_view mKey) noexcept
+    {
+        if(mKey.empty()) return std::size_t(0);
+
+        const auto f(static_cast<unsigned char>(mKey.front()));
+        const auto b(static_cast<unsigned char>(mKey.back()));
+        return (mKey.size() * 31 + f * 7 + b) % 64;
+    }
+
+    inline std::string_view internKey(std::string_view mKey)
+    {
+        auto& r(recent[getRecentIdx(mKey)]);
+        if(r.data() == nullptr || r != mKey) r = keys->intern(mKey);
+        return r;
+    }
+
+    inline auto& addNode(Val::Type mType)
+    {
+        auto& n(nodes.emplace_back());
+        n.type = mType;
+        return n;
+    }
+
+    inline void beginContainer(Val::Type mType)
+    {
+        addNode(mType);
+        stack.emplace_back(std::uint32_t(nodes.size() - 1));
+    }
+
+    inline void endContainer(std::uint32_t mStride)
+    {
+        const auto i(stack.back());
+        stack.pop_back();
+
+        const auto count(nodes.size() - i - 1);
+
+        auto& n(nodes[i]);
+        n.size = std::uint32_t(count / mStride);
+        n.children = arena.copyArr(nodes.data() + i + 1, count);
+
+        nodes.resize(i + 1);
+    }
+
+    inline void addStr(std::string_view mRaw, bool mEscaped)
+    {
+        auto& n(addNode(Val::Type::TStr));
+        n.str = mRaw.data();
+        n.size = std::uint32_t(mRaw.size());
+        n.escaped = mEscaped;
+    }
+
+public:
+    inline DocBuilder(
+        Arena& mArena, KeyTable* mKeys, std::vector<DocNode>& mNodes)
+        : arena{mArena}, keys{mKeys}, nodes{mNodes}
+    {
+        stack.reserve(16);
+    }
+
+    /// @brief Returns the root node, copied in the arena, or the null node
+    /// if nothing was read.
+    inline const DocNode* getRoot()
+    {
+        if(nodes.size() != 1) return &getNllDocNode();
+        return arena.copyArr(nodes.data(), 1);
+    }
+
+    inline void onObjBegin()
+    {
+        beginContainer(Val::Type::TObj);
+    }
+    inline void onObjEnd()
+    {
+        endContainer(2);
+    }
+    inline void onArrBegin()
+    {
+        beginContainer(Val::Type::TArr);
+    }
+    inline void onArrEnd()
+    {
+        endContainer(1);
+    }
+    inline void onKeyRaw(std::string_view mRaw, bool mEscaped)
+    {
+        if(keys == nullptr)
+        {
+            addStr(mRaw, mEscaped);
+            return;
+        }
+
+        if(SSVU_UNLIKELY(mEscaped))
+        {
+            keyBuf.clear();
+            unescapeStr(mRaw, keyBuf);
+            mRaw = keyBuf;
+        }
+
+        addStr(internKey(mRaw), false);
+    }
+    inline void onStrRaw(std::string_view mRaw, bool mEscaped)
+    {
+        addStr(mRaw, mEscaped);
+    }
+    inline void onNum(const Num& mNum)
+    {
+        addNode(Val::Type::TNum).num = mNum;
+    }
+    inline void onBln(Bln mBln)
+    {
+        addNode(Val::Type::TBln).bln = mBln;
+    }
+    inline void onNll()
+    {
+        addNode(Val::Type::TNll);
+    }
+};
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
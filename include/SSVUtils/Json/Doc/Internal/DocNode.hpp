@@ -0,0 +1,62 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_DOC_INTERNAL_DOCNODE
+#define SSVU_JSON_DOC_INTERNAL_DOCNODE
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Num/Num.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Node of a `Document`.
+/// @details The children of a container are stored contiguously in the
+/// document's arena. Objects store `2 * size` children: every value is
+/// preceded by a string node holding its key.
+struct DocNode
+{
+    Val::Type type{Val::Type::TNll};
+
+    /// @brief True if the string still contains escape sequences.
+    bool escaped{false};
+
+    /// @brief Number of elements of containers, or length of strings.
+    std::uint32_t size{0};
+
+    union
+    {
+        const char* str;
+        DocNode* children;
+        Num num;
+        Bln bln;
+    };
+
+    inline DocNode() noexcept : str{nullptr}
+    {
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<DocNode>,
+    "`DocNode` must be trivially copyable");
+
+/// @brief Returns the null node returned for missing keys and indices.
+inline const DocNode& getNllDocNode() noexcept
+{
+    static const DocNode result;
+    return result;
+}
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,138 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_DOC_KEYTABLE
+#define SSVU_JSON_DOC_KEYTABLE
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Doc/Internal/Arena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+/// @brief Intern table for object keys.
+/// @details Stores a single copy of every distinct key. Interned keys are
+/// views that stay valid until the table is cleared or destroyed, and two
+/// interned keys are equal if and only if their data pointers are equal.
+/// Can be shared by multiple `Document` instances, which must not outlive
+/// it. Not thread-safe.
+class KeyTable
+{
+private:
+    struct Entry
+    {
+        const char* str{nullptr};
+        std::size_t size{0};
+        std::size_t hash{0};
+    };
+
+    /// @brief Storage for the characters of interned keys.
+    Impl::Arena arena;
+
+    /// @brief Open-addressing table. Its size is a power of two, kept at
+    /// least twice the number of keys.
+    std::vector<Entry> entries;
+
+    std::size_t count{0};
+
+    inline static auto getHash(std::string_view mKey) noexcept
+    {
+        return std::hash<std::string_view>{}(mKey);
+    }
+
+    /// @brief Returns the slot holding `mKey`, or the empty slot where it
+    /// would be inserted.
+    inline auto findSlot(std::string_view mKey, std::size_t mHash) const
+        noexcept
+    {
+        const auto mask(entries.size() - 1);
+        auto s(mHash & mask);
+
+        for(; entries[s].str != nullptr; s = (s + 1) & mask)
+        {
+            const auto& e(entries[s]);
+            if(e.hash == mHash && std::string_view{e.str, e.size} == mKey)
+                break;
+        }
+
+        return s;
+    }
+
+    inline void grow()
+    {
+        std::vector<Entry> old(entries.empty() ? 64 : entries.size() * 2);
+        old.swap(entries);
+
+        for(const auto& e : old)
+            if(e.str != nullptr)
+                entries[findSlot({e.str, e.size}, e.hash)] = e;
+    }
+
+public:
+    inline KeyTable() = default;
+
+    KeyTable(const KeyTable&) = delete;
+    KeyTable& operator=(const KeyTable&) = delete;
+
+    KeyTable(KeyTable&&) = default;
+    KeyTable& operator=(KeyTable&&) = default;
+
+    /// @brief Returns the interned copy of `mKey`, adding it if necessary.
+    inline std::string_view intern(std::string_view mKey)
+    {
+        if(SSVU_UNLIKELY((count + 1) * 2 > entries.size())) grow();
+
+        const auto hash(getHash(mKey));
+        auto& e(entries[findSlot(mKey, hash)]);
+
+        if(e.str == nullptr)
+        {
+            // Empty keys still need a unique, non-null address
+            auto str(arena.allocArr<char>(std::max(mKey.size(), Idx(1))));
+            std::copy(std::begin(mKey), std::end(mKey), str);
+
+            e.str = str;
+            e.size = mKey.size();
+            e.hash = hash;
+            ++count;
+        }
+
+        return {e.str, e.size};
+    }
+
+    /// @brief Returns the interned copy of `mKey`, or a view with a null
+    /// data pointer if `mKey` was never interned.
+    inline std::string_view find(std::string_view mKey) const noexcept
+    {
+        if(count == 0) return {};
+
+        const auto& e(entries[findSlot(mKey, getHash(mKey))]);
+        return {e.str, e.size};
+    }
+
+    /// @brief Returns the number of interned keys.
+    inline auto getSize() const noexcept
+    {
+        return count;
+    }
+
+    /// @brief Removes all keys, invalidating the interned views.
+    inline void clear() noexcept
+    {
+        arena.clear();
+        entries.clear();
+        count = 0;
+    }
+};
+} // namespace Json
+} // namespace ssvu
+
+#endif
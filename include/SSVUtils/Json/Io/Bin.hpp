@@ -0,0 +1,392 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_BIN
+#define SSVU_JSON_IO_BIN
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Num/Num.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/ReadException.hpp"
+#include "SSVUtils/Json/Io/Io.hpp"
+#include "SSVUtils/Json/Io/Internal/WriterSinks.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Type tags of the binary encoding.
+/// @details Every value starts with a one-byte tag. Integers are stored as
+/// LEB128 varints (`IntS` is zigzag-encoded first), reals as their
+/// little-endian IEEE 754 bits. Strings are prefixed by their length,
+/// arrays and objects by their element count; object keys are stored as
+/// length-prefixed strings, each followed by its value.
+enum class BinTag : std::uint8_t
+{
+    TNll = 0,
+    TFalse = 1,
+    TTrue = 2,
+    TIntS = 3,
+    TIntU = 4,
+    TReal = 5,
+    TStr = 6,
+    TArr = 7,
+    TObj = 8
+};
+
+/// @brief Maximum size of an encoded varint.
+constexpr std::size_t binMaxVarIntSize{10};
+
+/// @brief Writes `Val` instances to `TSink` in the binary encoding.
+template <typename TSink>
+class BinWriter
+{
+private:
+    TSink& sink;
+
+    inline void wTag(BinTag mTag)
+    {
+        sink.put(char(mTag));
+    }
+
+    inline void wVarInt(std::uint64_t mX)
+    {
+        char buf[binMaxVarIntSize];
+        std::size_t size{0};
+
+        for(; mX >= 0x80; mX >>= 7) buf[size++] = char(mX | 0x80);
+        buf[size++] = char(mX);
+
+        sink.put(std::string_view(buf, size));
+    }
+
+    inline void wBytes(std::string_view mStr)
+    {
+        wVarInt(mStr.size());
+        sink.put(mStr);
+    }
+
+    inline void wReal(Real mX)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &mX, sizeof(bits));
+
+        char buf[sizeof(bits)];
+        for(auto& c : buf)
+        {
+            c = char(bits);
+            bits >>= 8;
+        }
+
+        sink.put(std::string_view(buf, sizeof(buf)));
+    }
+
+    inline void write(const Num& mNum)
+    {
+        switch(mNum.getRepr())
+        {
+            case Num::Repr::IntS:
+            {
+                const auto x(std::uint64_t(mNum.as<IntS>()));
+
+                wTag(BinTag::TIntS);
+                wVarInt((x << 1) ^ (0 - (x >> 63)));
+                return;
+            }
+            case Num::Repr::IntU:
+                wTag(BinTag::TIntU);
+                wVarInt(mNum.as<IntU>());
+                return;
+            case Num::Repr::Real:
+                wTag(BinTag::TReal);
+                wReal(mNum.as<Real>());
+                return;
+        }
+    }
+
+public:
+    inline BinWriter(TSink& mSink) noexcept : sink{mSink}
+    {
+    }
+
+    /// @brief Writes `mVal` to the sink, without flushing it.
+    template <bool THashedObj, bool TCow>
+    inline void write(const ValImpl<THashedObj, TCow>& mVal)
+    {
+        using V = ValImpl<THashedObj, TCow>;
+
+        switch(mVal.getType())
+        {
+            case ValType::TObj:
+                wTag(BinTag::TObj);
+                wVarInt(mVal.getSizeObj());
+                for(const auto& p : mVal.template as<typename V::Obj>())
+                {
+                    wBytes(p.first);
+                    write(p.second);
+                }
+                return;
+            case ValType::TArr:
+                wTag(BinTag::TArr);
+                wVarInt(mVal.getSizeArr());
+                if(!mVal.visitNumArr([this](const auto& mItems) {
+                       for(auto x : mItems) write(Num{x});
+                   }))
+                    for(const auto& v : mVal.template as<typename V::Arr>())
+                        write(v);
+                return;
+            case ValType::TStr:
+                wTag(BinTag::TStr);
+                wBytes(mVal.template as<Str>());
+                return;
+            case ValType::TNum: write(mVal.template as<Num>()); return;
+            case ValType::TBln:
+                wTag(mVal.template as<Bln>() ? BinTag::TTrue
+                                             : BinTag::TFalse);
+                return;
+            case ValType::TNll: wTag(BinTag::TNll); return;
+            default: SSVU_UNREACHABLE();
+        }
+    }
+};
+
+/// @brief Builds `Val` instances from their binary encoding.
+/// @details Every length and count is checked against the remaining input
+/// before memory is reserved for it, so truncated or corrupted input
+/// throws a `ReadException` instead of allocating huge containers.
+class BinReader
+{
+private:
+    std::string_view src;
+    Idx idx{0};
+
+    [[noreturn]] inline void throwError(std::string mBody)
+    {
+        throw ReadException{"Invalid binary value", std::move(mBody),
+            "byte " + toStr(idx) + " of " + toStr(src.size())};
+    }
+
+    inline auto getRemaining() const noexcept
+    {
+        return src.size() - idx;
+    }
+
+    inline auto rByte()
+    {
+        if(SSVU_UNLIKELY(idx == src.size())) throwError("Unexpected end");
+        return std::uint8_t(src[idx++]);
+    }
+
+    inline std::uint64_t rVarInt()
+    {
+        std::uint64_t result{0};
+
+        for(unsigned int shift{0}; shift < 64; shift += 7)
+        {
+            const auto b(rByte());
+            result |= std::uint64_t(b & 0x7F) << shift;
+            if((b & 0x80) == 0) return result;
+        }
+
+        throwError("Varint too long");
+    }
+
+    /// @brief Reads a count of elements that take at least `mMinSize`
+    /// bytes each.
+    inline std::size_t rCount(std::size_t mMinSize)
+    {
+        const auto result(rVarInt());
+        if(SSVU_UNLIKELY(result > getRemaining() / mMinSize))
+            throwError("Length exceeds the remaining input");
+
+        return std::size_t(result);
+    }
+
+    inline auto rBytes()
+    {
+        const auto size(rCount(1));
+        const auto result(src.substr(idx, size));
+        idx += size;
+        return result;
+    }
+
+    inline auto rReal()
+    {
+        if(SSVU_UNLIKELY(getRemaining() < sizeof(std::uint64_t)))
+            throwError("Unexpected end");
+
+        std::uint64_t bits{0};
+        for(auto i(0u); i < sizeof(bits); ++i)
+            bits |= std::uint64_t(std::uint8_t(src[idx + i])) << (i * 8);
+        idx += sizeof(bits);
+
+        Real result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    /// @brief Returns the value of `mObj` with the newly read key `mKey`.
+    template <typename TObj>
+    inline static auto& getObjItem(TObj& mObj, Key&& mKey)
+    {
+        using V = typename TObj::Item::second_type;
+
+        // Sorted objects are written in order: keys can be appended
+        // directly
+        if constexpr(std::is_same_v<TObj, VecMap<Key, V>>)
+        {
+            auto& data(mObj.getData());
+            if(SSVU_LIKELY(data.empty() || data.back().first < mKey))
+                return data.emplace_back(std::move(mKey), V{}).second;
+        }
+
+        return mObj[std::move(mKey)];
+    }
+
+    template <bool THashedObj, bool TCow>
+    inline void rObj(ValImpl<THashedObj, TCow>& mVal)
+    {
+        using V = ValImpl<THashedObj, TCow>;
+        const auto size(rCount(2));
+
+        mVal = typename V::Obj{};
+        auto& obj(mVal.template as<typename V::Obj>());
+        obj.reserve(size);
+
+        for(auto i(0u); i < size; ++i) read(getObjItem(obj, Key{rBytes()}));
+    }
+
+    template <bool THashedObj, bool TCow>
+    inline void rArr(ValImpl<THashedObj, TCow>& mVal)
+    {
+        using V = ValImpl<THashedObj, TCow>;
+        const auto size(rCount(1));
+
+        mVal = typename V::Arr{};
+        auto& arr(mVal.template as<typename V::Arr>());
+        arr.resize(size);
+
+        for(auto& v : arr) read(v);
+    }
+
+public:
+    inline BinReader(std::string_view mSrc) noexcept : src{mSrc}
+    {
+    }
+
+    /// @brief Reads the next value into `mVal`.
+    template <bool THashedObj, bool TCow>
+    inline void read(ValImpl<THashedObj, TCow>& mVal)
+    {
+        switch(BinTag(rByte()))
+        {
+            case BinTag::TNll: mVal = Nll{}; return;
+            case BinTag::TFalse: mVal = false; return;
+            case BinTag::TTrue: mVal = true; return;
+            case BinTag::TIntS:
+            {
+                const auto x(rVarInt());
+                mVal = Num{IntS((x >> 1) ^ (0 - (x & 1)))};
+                return;
+            }
+            case BinTag::TIntU: mVal = Num{IntU(rVarInt())}; return;
+            case BinTag::TReal: mVal = Num{rReal()}; return;
+            case BinTag::TStr: mVal = Str{rBytes()}; return;
+            case BinTag::TArr: rArr(mVal); return;
+            case BinTag::TObj: rObj(mVal); return;
+        }
+
+        --idx;
+        throwError("Invalid type tag");
+    }
+
+    /// @brief Reads a single value, which must span the whole input.
+    template <typename TV = Val>
+    inline TV readAll()
+    {
+        TV result;
+        read(result);
+
+        if(SSVU_UNLIKELY(idx != src.size()))
+            throwError("Unexpected data after the value");
+
+        return result;
+    }
+};
+
+/// @brief Writes `mVal` to `mSink` in the binary encoding and flushes it,
+/// returning false if the sink failed.
+template <typename TSink, bool THashedObj, bool TCow>
+inline bool writeToSinkBin(const ValImpl<THashedObj, TCow>& mVal, TSink& mSink)
+{
+    BinWriter<TSink>{mSink}.write(mVal);
+    return mSink.flush();
+}
+
+template <bool THashedObj, bool TCow>
+inline void ValImpl<THashedObj, TCow>::writeToBinStream(
+    std::ostream& mStream) const
+{
+    StreamSink s{{&mStream}};
+    writeToSinkBin(*this, s);
+    mStream.flush();
+}
+template <bool THashedObj, bool TCow>
+inline void ValImpl<THashedObj, TCow>::writeToBinStr(std::string& mStr) const
+{
+    mStr.clear();
+    StrSink s{mStr};
+    writeToSinkBin(*this, s);
+}
+template <bool THashedObj, bool TCow>
+inline bool ValImpl<THashedObj, TCow>::writeToBinFile(
+    const ssvufs::Path& mPath) const
+{
+    auto file(std::fopen(mPath.getCStr(), "wb"));
+    if(file == nullptr) return false;
+
+    CFileSink s{{file}};
+    const auto result(writeToSinkBin(*this, s));
+    return std::fclose(file) == 0 && result;
+}
+template <bool THashedObj, bool TCow>
+inline void ValImpl<THashedObj, TCow>::readFromBinStr(std::string_view mStr)
+{
+    tryRead([&] { *this = BinReader{mStr}.readAll<ValImpl>(); });
+}
+template <bool THashedObj, bool TCow>
+inline void ValImpl<THashedObj, TCow>::readFromBinFile(
+    const ssvufs::Path& mPath)
+{
+    const ssvufs::MappedFile file{mPath};
+    readFromBinStr(file.getView());
+}
+} // namespace Impl
+
+/// @brief Returns a JSON value decoded from the binary encoding in `mStr`.
+inline auto fromBinStr(std::string_view mStr)
+{
+    return Val::fromBinStr(mStr);
+}
+
+/// @brief Returns a JSON value decoded from the binary file in `mPath`.
+inline auto fromBinFile(const ssvufs::Path& mPath)
+{
+    return Val::fromBinFile(mPath);
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,519 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_CHUNKREADER
+#define SSVU_JSON_IO_CHUNKREADER
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/ReadException.hpp"
+#include "SSVUtils/Json/Io/Reader.hpp"
+#include "SSVUtils/Json/Io/SaxHandler.hpp"
+#include "SSVUtils/Json/Io/ValBuilder.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Resumable JSON reader, fed with chunks of input as they arrive.
+/// @details Reading state is kept across `feed` calls, so chunks can be
+/// split anywhere, even in the middle of a string or a number. Any number
+/// of whitespace-separated values can be read in sequence, which makes the
+/// reader suitable for newline-delimited streams. Memory usage is bounded
+/// by the nesting depth and by the size of the longest string or number.
+class ChunkReader
+{
+private:
+    /// @brief Token expected by the reader outside of strings, numbers,
+    /// literals and comments.
+    enum class Expect
+    {
+        Value,
+        ValueOrArrEnd,
+        KeyOrObjEnd,
+        Key,
+        Colon,
+        CommaOrEnd
+    };
+
+    /// @brief Token currently being read, possibly across chunks.
+    enum class Tok
+    {
+        None,
+        Str,
+        StrEscape,
+        Num,
+        Lit,
+        CommentStart,
+        Comment
+    };
+
+    /// @brief Open containers, as `'{'` or `'['`, innermost last.
+    std::vector<char> stack;
+
+    /// @brief Characters of the current string, number or literal.
+    std::string tokBuf;
+
+    Expect expect{Expect::Value};
+    Tok tok{Tok::None};
+
+    /// @brief True if the current string is an object key.
+    bool strIsKey{false};
+
+    /// @brief True if the current string contains escape sequences, which
+    /// are kept raw in `tokBuf` until the string ends.
+    bool strEscaped{false};
+
+    /// @brief Storage for unescaped strings.
+    std::string strBuf;
+
+    /// @brief Number of characters fed before the current chunk.
+    std::size_t offset{0};
+
+    /// @brief Builder used by `feedVals` and `finishVals`.
+    ValBuilder<Val> builder;
+
+    [[noreturn]] inline void throwError(std::string mTitle,
+        std::string mBody, std::string_view mChunk, std::size_t mI)
+    {
+        const auto iStart(mI < 20 ? 0 : mI - 20);
+        const auto iEnd(std::min(mChunk.size(), mI + 20));
+
+        std::string chunkSrc{mChunk.substr(iStart, iEnd - iStart)};
+        replaceAll(chunkSrc, "\n", "");
+
+        throw ReadException{std::move(mTitle),
+            std::move(mBody) + " (offset " + toStr(offset + mI) + ")",
+            std::move(chunkSrc)};
+    }
+
+    /// @brief Called after a complete value has been read.
+    template <typename TF>
+    inline void endVal(TF& mOnDone)
+    {
+        if(!stack.empty())
+        {
+            expect = Expect::CommaOrEnd;
+            return;
+        }
+
+        expect = Expect::Value;
+        mOnDone();
+    }
+
+    template <typename TH, typename TF>
+    inline void endContainer(TH& mH, TF& mOnDone)
+    {
+        if(stack.back() == '{')
+            mH.onObjEnd();
+        else
+            mH.onArrEnd();
+
+        stack.pop_back();
+        endVal(mOnDone);
+    }
+
+    template <typename TH, typename TF>
+    inline void endStr(std::string_view mStr, TH& mH, TF& mOnDone)
+    {
+        tok = Tok::None;
+
+        if(strIsKey)
+        {
+            mH.onKey(mStr);
+            expect = Expect::Colon;
+            return;
+        }
+
+        mH.onStr(mStr);
+        endVal(mOnDone);
+    }
+
+    template <typename TH, typename TF>
+    inline void endNum(
+        TH& mH, TF& mOnDone, std::string_view mChunk, std::size_t mI)
+    {
+        Num num;
+        if(SSVU_UNLIKELY(strToNum(tokBuf, num) != tokBuf.size()))
+            throwError("Invalid number",
+                "Couldn't parse number `" + tokBuf + "`", mChunk, mI);
+
+        tok = Tok::None;
+        mH.onNum(num);
+        endVal(mOnDone);
+    }
+
+    template <typename TH, typename TF>
+    inline void endLit(
+        TH& mH, TF& mOnDone, std::string_view mChunk, std::size_t mI)
+    {
+        if(tokBuf == "true")
+            mH.onBln(true);
+        else if(tokBuf == "false")
+            mH.onBln(false);
+        else if(tokBuf == "null")
+            mH.onNll();
+        else
+            throwError("Invalid keyword",
+                "Couldn't match keyword `" + tokBuf + "`", mChunk, mI);
+
+        tok = Tok::None;
+        endVal(mOnDone);
+    }
+
+    /// @brief Handles the character `mChunk[mI]`, which is neither
+    /// whitespace nor part of a token.
+    template <typename TH, typename TF>
+    inline void readStructural(
+        TH& mH, TF& mOnDone, std::string_view mChunk, std::size_t mI)
+    {
+        const auto c(mChunk[mI]);
+
+        switch(expect)
+        {
+            case Expect::ValueOrArrEnd:
+                if(c == ']')
+                {
+                    endContainer(mH, mOnDone);
+                    return;
+                }
+
+                // fall through
+            case Expect::Value:
+                if(c == '{')
+                {
+                    mH.onObjBegin();
+                    stack.emplace_back('{');
+                    expect = Expect::KeyOrObjEnd;
+                    return;
+                }
+
+                if(c == '[')
+                {
+                    mH.onArrBegin();
+                    stack.emplace_back('[');
+                    expect = Expect::ValueOrArrEnd;
+                    return;
+                }
+
+                if(c == '"')
+                {
+                    tok = Tok::Str;
+                    strIsKey = strEscaped = false;
+                    tokBuf.clear();
+                    return;
+                }
+
+                if(isNumStart(c))
+                {
+                    tok = Tok::Num;
+                    tokBuf.assign(1, c);
+                    return;
+                }
+
+                if(c == 't' || c == 'f' || c == 'n')
+                {
+                    tok = Tok::Lit;
+                    tokBuf.assign(1, c);
+                    return;
+                }
+
+                throwError("Invalid value",
+                    std::string{"No match for values beginning with `"} + c +
+                        "`",
+                    mChunk, mI);
+
+            case Expect::KeyOrObjEnd:
+                if(c == '}')
+                {
+                    endContainer(mH, mOnDone);
+                    return;
+                }
+
+                // fall through
+            case Expect::Key:
+                if(c == '"')
+                {
+                    tok = Tok::Str;
+                    strIsKey = true;
+                    strEscaped = false;
+                    tokBuf.clear();
+                    return;
+                }
+
+                throwError("Invalid object",
+                    std::string{"Expected `\"` , got `"} + c + "`", mChunk, mI);
+
+            case Expect::Colon:
+                if(c == ':')
+                {
+                    expect = Expect::Value;
+                    return;
+                }
+
+                throwError("Invalid object",
+                    std::string{"Expected `:` , got `"} + c + "`", mChunk, mI);
+
+            case Expect::CommaOrEnd:
+                if(c == ',')
+                {
+                    expect = stack.back() == '{' ? Expect::Key : Expect::Value;
+                    return;
+                }
+
+                if(c == (stack.back() == '{' ? '}' : ']'))
+                {
+                    endContainer(mH, mOnDone);
+                    return;
+                }
+
+                throwError(stack.back() == '{' ? "Invalid object"
+                                               : "Invalid array",
+                    std::string{"Expected either `,` or `"} +
+                        (stack.back() == '{' ? '}' : ']') + "`, got `" + c +
+                        "`",
+                    mChunk, mI);
+        }
+    }
+
+public:
+    inline ChunkReader()
+    {
+        stack.reserve(16);
+    }
+
+    /// @brief Reads `mChunk`, forwarding reading events to `mH` and
+    /// calling `mOnDone` after every complete top-level value.
+    /// @details `TH` is expected to provide the same interface as
+    /// `SaxHandler`. Throws `ReadException` on malformed input, after
+    /// which the reader must be `reset`.
+    template <typename TH, typename TF>
+    inline void feed(std::string_view mChunk, TH& mH, TF&& mOnDone)
+    {
+        for(std::size_t i{0}; i < mChunk.size();)
+        {
+            switch(tok)
+            {
+                case Tok::None:
+                {
+                    const auto c(mChunk[i]);
+
+                    if(isWhitespace(c))
+                        ++i;
+                    else if(c == '/')
+                    {
+                        tok = Tok::CommentStart;
+                        ++i;
+                    }
+                    else
+                    {
+                        readStructural(mH, mOnDone, mChunk, i);
+                        ++i;
+                    }
+
+                    break;
+                }
+
+                case Tok::Str:
+                {
+                    // Find the end of the current run of characters
+                    auto j(i);
+                    while(j < mChunk.size() && mChunk[j] != '"' &&
+                          mChunk[j] != '\\')
+                        ++j;
+
+                    const auto run(mChunk.substr(i, j - i));
+                    i = j;
+
+                    // The string continues in the next chunk
+                    if(j == mChunk.size())
+                    {
+                        tokBuf += run;
+                        break;
+                    }
+
+                    ++i;
+
+                    if(mChunk[j] == '\\')
+                    {
+                        tokBuf += run;
+                        tok = Tok::StrEscape;
+                        break;
+                    }
+
+                    // Strings entirely contained in the chunk are not
+                    // copied
+                    if(tokBuf.empty())
+                        endStr(run, mH, mOnDone);
+                    else if(!strEscaped)
+                    {
+                        tokBuf += run;
+                        endStr(tokBuf, mH, mOnDone);
+                    }
+                    else
+                    {
+                        tokBuf += run;
+                        if(SSVU_UNLIKELY(!areEscapesValid(tokBuf)))
+                            throwError("Invalid string",
+                                "Invalid unicode escape sequence", mChunk, j);
+
+                        unescapeStr(tokBuf, strBuf);
+                        endStr(strBuf, mH, mOnDone);
+                    }
+
+                    break;
+                }
+
+                case Tok::StrEscape:
+                    if(SSVU_UNLIKELY(!isValidEscapeSequenceChar(mChunk[i])))
+                        throwError("Invalid string",
+                            std::string{"Invalid escape sequence `\\"} +
+                                mChunk[i] + "`",
+                            mChunk, i);
+
+                    tokBuf += '\\';
+                    tokBuf += mChunk[i];
+                    strEscaped = true;
+                    tok = Tok::Str;
+                    ++i;
+                    break;
+
+                case Tok::Num:
+                case Tok::Lit:
+                {
+                    auto j(i);
+                    if(tok == Tok::Num)
+                        while(j < mChunk.size() && isNumChar(mChunk[j])) ++j;
+                    else
+                        while(j < mChunk.size() && mChunk[j] >= 'a' &&
+                              mChunk[j] <= 'z')
+                            ++j;
+
+                    tokBuf.append(mChunk.data() + i, j - i);
+                    i = j;
+
+                    // The token may continue in the next chunk
+                    if(j == mChunk.size()) break;
+
+                    if(tok == Tok::Num)
+                        endNum(mH, mOnDone, mChunk, i);
+                    else
+                        endLit(mH, mOnDone, mChunk, i);
+
+                    break;
+                }
+
+                case Tok::CommentStart:
+                    if(SSVU_UNLIKELY(mChunk[i] != '/'))
+                        throwError("Invalid comment",
+                            std::string{"Expected `/`, got `"} + mChunk[i] +
+                                "`",
+                            mChunk, i);
+
+                    tok = Tok::Comment;
+                    ++i;
+                    break;
+
+                case Tok::Comment:
+                {
+                    auto nl(static_cast<const char*>(std::memchr(
+                        mChunk.data() + i, '\n', mChunk.size() - i)));
+
+                    if(nl == nullptr)
+                    {
+                        i = mChunk.size();
+                        break;
+                    }
+
+                    i = nl - mChunk.data() + 1;
+                    tok = Tok::None;
+                    break;
+                }
+            }
+        }
+
+        offset += mChunk.size();
+    }
+
+    template <typename TH>
+    inline void feed(std::string_view mChunk, TH& mH)
+    {
+        feed(mChunk, mH, [] {});
+    }
+
+    /// @brief Signals the end of the input, completing any pending number
+    /// or literal.
+    /// @details Throws `ReadException` if the input ends in the middle of
+    /// a value. The reader can be fed again afterwards.
+    template <typename TH, typename TF>
+    inline void finish(TH& mH, TF&& mOnDone)
+    {
+        if(tok == Tok::Num)
+            endNum(mH, mOnDone, {}, 0);
+        else if(tok == Tok::Lit)
+            endLit(mH, mOnDone, {}, 0);
+        else if(tok == Tok::Comment)
+            tok = Tok::None;
+
+        if(SSVU_UNLIKELY(tok != Tok::None || !stack.empty() ||
+                         expect != Expect::Value))
+            throwError("Invalid input", "Unexpected end of input", {}, 0);
+
+        offset = 0;
+    }
+
+    template <typename TH>
+    inline void finish(TH& mH)
+    {
+        finish(mH, [] {});
+    }
+
+    /// @brief Reads `mChunk`, calling `mF` with every complete top-level
+    /// value as a `Val&&`.
+    template <typename TF>
+    inline void feedVals(std::string_view mChunk, TF&& mF)
+    {
+        feed(mChunk, builder, [&] { mF(std::move(builder.getResult())); });
+    }
+
+    /// @brief Signals the end of the input to `feedVals`.
+    template <typename TF>
+    inline void finishVals(TF&& mF)
+    {
+        finish(builder, [&] { mF(std::move(builder.getResult())); });
+    }
+
+    /// @brief Discards the reading state, including partially read values.
+    inline void reset()
+    {
+        stack.clear();
+        tokBuf.clear();
+        expect = Expect::Value;
+        tok = Tok::None;
+        offset = 0;
+        builder = ValBuilder<Val>{};
+    }
+
+    /// @brief Returns true if no value is partially read.
+    inline bool isIdle() const noexcept
+    {
+        return stack.empty() && expect == Expect::Value &&
+               (tok == Tok::None || tok == Tok::Comment);
+    }
+};
+} // namespace Impl
+
+using ChunkReader = Impl::ChunkReader;
+} // namespace Json
+} // namespace ssvu
+
+#endif
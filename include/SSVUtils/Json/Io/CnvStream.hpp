@@ -0,0 +1,248 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_CNVSTREAM
+#define SSVU_JSON_IO_CNVSTREAM
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Val/Internal/Cnv.hpp"
+#include "SSVUtils/Json/Val/Internal/CnvFuncs.hpp"
+#include "SSVUtils/Json/Io/Io.hpp"
+#include "SSVUtils/Json/Io/SaxHandler.hpp"
+
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Source handed to streamable converters instead of a `Val`.
+/// @details `cnv`, `cnvArr` and `cnvObj` read their arguments directly from
+/// the underlying reader.
+template <typename TRS>
+struct CnvStream
+{
+    Reader<TRS>& reader;
+};
+
+/// @brief True if `Cnv<T>` was marked with `SSVJ_CNV_STREAMABLE`.
+template <typename T, typename = void>
+struct IsCnvStreamable : std::false_type
+{
+};
+template <typename T>
+struct IsCnvStreamable<T, ssvu::Impl::VoidT<decltype(Cnv<T>::streamable)>>
+    : std::bool_constant<Cnv<T>::streamable>
+{
+};
+
+/// @brief True if `T` is a vector whose elements can be read in place.
+template <typename T>
+struct IsCnvStreamVec : std::false_type
+{
+};
+template <typename TItem>
+struct IsCnvStreamVec<std::vector<TItem>>
+    : std::bool_constant<!std::is_same_v<TItem, bool>>
+{
+};
+
+/// @brief True if `T` is a scalar read without a temporary `Val`.
+template <typename T>
+constexpr bool isCnvStreamScalar{std::is_arithmetic_v<T> ||
+                                 std::is_same_v<T, Str>};
+
+/// @brief SAX handler that stores a scalar value in `x`.
+/// @details Values of any other type are consumed and ignored.
+template <typename T>
+struct CnvScalarHandler : SaxHandler
+{
+    T& x;
+
+    /// @brief Depth of the containers being ignored.
+    std::size_t depth{0};
+
+    inline CnvScalarHandler(T& mX) noexcept : x{mX}
+    {
+    }
+
+    inline void onObjBegin() noexcept
+    {
+        ++depth;
+    }
+    inline void onObjEnd() noexcept
+    {
+        --depth;
+    }
+    inline void onArrBegin() noexcept
+    {
+        ++depth;
+    }
+    inline void onArrEnd() noexcept
+    {
+        --depth;
+    }
+    inline void onStr(std::string_view mStr)
+    {
+        if constexpr(std::is_same_v<T, Str>)
+            if(depth == 0) x.assign(mStr);
+    }
+    inline void onNum(const Num& mNum) noexcept
+    {
+        if constexpr(std::is_arithmetic_v<T> && !std::is_same_v<T, Bln>)
+            if(depth == 0) x = mNum.as<T>();
+    }
+    inline void onBln(Bln mBln) noexcept
+    {
+        if constexpr(std::is_same_v<T, Bln>)
+            if(depth == 0) x = mBln;
+    }
+};
+
+/// @brief Reads the next value of `mR` into `mX`.
+/// @details Streamable converters, vectors and scalars are driven by the
+/// reader. Any other type is read into a temporary `Val` and converted
+/// with its regular converter.
+template <typename TRS, typename T>
+inline void readCnv(Reader<TRS>& mR, T& mX)
+{
+    if constexpr(IsCnvStreamable<T>{})
+    {
+        CnvStream<TRS> s{mR};
+        Cnv<T>::template impl<CnvStream<TRS>&, T&>(s, mX);
+    }
+    else if constexpr(IsCnvStreamVec<T>{})
+    {
+        mX.clear();
+        mR.readArr([&] { readCnv(mR, mX.emplace_back()); });
+    }
+    else if constexpr(isCnvStreamScalar<T>)
+    {
+        CnvScalarHandler<T> h{mX};
+        mR.parse(h);
+    }
+    else
+        extr(mR.parseVal(), mX);
+}
+
+struct CnvStreamHelper
+{
+    template <std::size_t TS>
+    inline static constexpr auto getKeyView(const char (&mKey)[TS]) noexcept
+    {
+        return std::string_view{mKey, TS - 1};
+    }
+    inline static auto getKeyView(std::string_view mKey) noexcept
+    {
+        return mKey;
+    }
+
+    /// @brief Reads the next value into the `mI`-th argument, returning
+    /// false if there is none.
+    template <typename TRS, std::size_t... TIs, typename... TArgs>
+    inline static bool hReadArr(Reader<TRS>& mR, std::size_t mI,
+        std::index_sequence<TIs...>, TArgs&... mArgs)
+    {
+        return ((mI == TIs && (readCnv(mR, mArgs), true)) || ...);
+    }
+
+    /// @brief Reads the next value into the argument following the key
+    /// `mKey`, returning false if there is none.
+    template <typename TRS>
+    inline static bool hReadObj(Reader<TRS>&, std::string_view) noexcept
+    {
+        return false;
+    }
+    template <typename TRS, typename TKey, typename TArg, typename... TArgs>
+    inline static bool hReadObj(Reader<TRS>& mR, std::string_view mKey,
+        const TKey& mK, TArg& mArg, TArgs&... mArgs)
+    {
+        if(mKey != getKeyView(mK)) return hReadObj(mR, mKey, mArgs...);
+
+        readCnv(mR, mArg);
+        return true;
+    }
+};
+} // namespace Impl
+
+template <typename TRS, typename T>
+inline void cnv(Impl::CnvStream<TRS>& mS, T& mX)
+{
+    Impl::readCnv(mS.reader, mX);
+}
+
+/// @brief Reads the elements of an array into `mArgs`, in order.
+/// @details Missing elements are left untouched, extra elements are
+/// skipped.
+template <typename TRS, typename... TArgs>
+inline void cnvArr(Impl::CnvStream<TRS>& mS, TArgs&... mArgs)
+{
+    std::size_t i{0};
+    mS.reader.readArr([&] {
+        if(!Impl::CnvStreamHelper::hReadArr(mS.reader, i++,
+               std::index_sequence_for<TArgs...>{}, mArgs...))
+            mS.reader.skip();
+    });
+}
+
+/// @brief Reads the values of an object into `mArgs`, which alternate keys
+/// and destinations.
+/// @details Keys are matched against the names passed to the converter, in
+/// any order. Missing keys are left untouched, unknown keys are skipped.
+template <typename TRS, typename... TArgs>
+inline void cnvObj(Impl::CnvStream<TRS>& mS, TArgs&... mArgs)
+{
+    mS.reader.readObj([&](std::string_view mKey) {
+        if(!Impl::CnvStreamHelper::hReadObj(mS.reader, mKey, mArgs...))
+            mS.reader.skip();
+    });
+}
+
+/// @brief Reads `mStr` directly into `mX`, without building a `Val` tree
+/// when `mX`'s converter is streamable.
+/// @details Returns `false` if a reading error occurred, in which case
+/// `mX` may be partially read.
+template <typename TRS = RSDefault, typename T, typename TX>
+inline bool extrFromStr(T&& mStr, TX& mX)
+{
+    Impl::Reader<TRS> r{FWD(mStr)};
+    return Impl::tryRead([&] { Impl::readCnv(r, mX); });
+}
+
+/// @brief Reads the file in `mPath` directly into `mX`.
+template <typename TRS = RSDefault, typename TX>
+inline bool extrFromFile(const ssvufs::Path& mPath, TX& mX)
+{
+    const ssvufs::MappedFile file{mPath};
+    return extrFromStr<TRS>(file.getView(), mX);
+}
+
+/// @brief Returns a `TX` read directly from `mStr`.
+template <typename TX, typename TRS = RSDefault, typename T>
+inline TX getExtrFromStr(T&& mStr)
+{
+    TX result;
+    extrFromStr<TRS>(FWD(mStr), result);
+    return result;
+}
+
+/// @brief Returns a `TX` read directly from the file in `mPath`.
+template <typename TX, typename TRS = RSDefault>
+inline TX getExtrFromFile(const ssvufs::Path& mPath)
+{
+    TX result;
+    extrFromFile<TRS>(mPath, result);
+    return result;
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
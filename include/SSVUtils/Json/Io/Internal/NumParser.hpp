@@ -0,0 +1,317 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_INTERNAL_NUMPARSER
+#define SSVU_JSON_IO_INTERNAL_NUMPARSER
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Num/Num.hpp"
+#include "SSVUtils/Json/Io/Internal/Pow5Table.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+static_assert(std::numeric_limits<Real>::is_iec559 &&
+                  sizeof(Real) == sizeof(std::uint64_t),
+    "`Real` must be an IEEE 754 binary64 floating point type");
+
+/// @brief Number of decimal digits that always fit in an `std::uint64_t`.
+constexpr int maxExactDigits{19};
+
+/// @brief Stores the 128-bit product of `mA` and `mB` in `mHi` and `mLo`.
+inline void mul128(std::uint64_t mA, std::uint64_t mB, std::uint64_t& mHi,
+    std::uint64_t& mLo) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const auto r(static_cast<unsigned __int128>(mA) * mB);
+    mHi = static_cast<std::uint64_t>(r >> 64);
+    mLo = static_cast<std::uint64_t>(r);
+#else
+    const std::uint64_t aLo{mA & 0xFFFFFFFFu}, aHi{mA >> 32};
+    const std::uint64_t bLo{mB & 0xFFFFFFFFu}, bHi{mB >> 32};
+
+    const auto ll(aLo * bLo), lh(aLo * bHi), hl(aHi * bLo), hh(aHi * bHi);
+    const auto mid((ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu));
+
+    mHi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    mLo = (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+}
+
+/// @brief Returns the number of leading zero bits of `mX`, which must not
+/// be zero.
+inline int clz64(std::uint64_t mX) noexcept
+{
+#if(defined(SSVU_COMPILER_CLANG) || defined(SSVU_COMPILER_GCC))
+    return __builtin_clzll(mX);
+#else
+    auto result(0);
+    for(; (mX & (std::uint64_t(1) << 63)) == 0; mX <<= 1) ++result;
+    return result;
+#endif
+}
+
+/// @brief Returns the bits of the `Real` closest to `mW * 10^mQ`, without
+/// the sign, using the Eisel-Lemire algorithm.
+/// @details The refined 128-bit product is always sufficient to determine
+/// the correctly rounded result when `mW` holds all the digits.
+inline std::uint64_t eiselLemire(std::uint64_t mW, std::int64_t mQ) noexcept
+{
+    constexpr int mantissaBits{52}, minExp{-1023}, infExp{0x7FF};
+
+    if(mW == 0 || mQ < pow5TableMinExp) return 0;
+    if(mQ > pow5TableMaxExp) return std::uint64_t(infExp) << mantissaBits;
+
+    const auto lz(clz64(mW));
+    mW <<= lz;
+
+    // Multiply by the truncated power of five, refining the product with
+    // the lower half of the power only when it could change the result
+    const auto pIdx(2 * std::size_t(mQ - pow5TableMinExp));
+    std::uint64_t hi, lo;
+    mul128(mW, pow5Table[pIdx], hi, lo);
+
+    constexpr auto precisionMask(~std::uint64_t(0) >> (mantissaBits + 3));
+    if((hi & precisionMask) == precisionMask)
+    {
+        std::uint64_t hi2, lo2;
+        mul128(mW, pow5Table[pIdx + 1], hi2, lo2);
+
+        lo += hi2;
+        if(hi2 > lo) ++hi;
+    }
+
+    const auto upperBit(int(hi >> 63));
+    const auto shift(upperBit + 64 - mantissaBits - 3);
+    auto mantissa(hi >> shift);
+
+    // floor(log2(10^q)) + 63, biased
+    const auto log2Pow10(int(((152170 + 65536) * mQ) >> 16));
+    auto exp2(log2Pow10 + 63 + upperBit - lz - minExp);
+
+    if(exp2 <= 0)
+    {
+        // Subnormal result
+        if(-exp2 + 1 >= 64) return 0;
+
+        mantissa >>= -exp2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+
+        exp2 = mantissa < (std::uint64_t(1) << mantissaBits) ? 0 : 1;
+        return (mantissa & ~(std::uint64_t(1) << mantissaBits)) |
+               (std::uint64_t(exp2) << mantissaBits);
+    }
+
+    // Exact halfway cases must be rounded to even
+    if(lo <= 1 && mQ >= -4 && mQ <= 23 && (mantissa & 3) == 1 &&
+        (mantissa << shift) == hi)
+        mantissa &= ~std::uint64_t(1);
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+
+    if(mantissa >= (std::uint64_t(2) << mantissaBits))
+    {
+        mantissa = std::uint64_t(1) << mantissaBits;
+        ++exp2;
+    }
+
+    mantissa &= ~(std::uint64_t(1) << mantissaBits);
+
+    if(exp2 >= infExp)
+    {
+        exp2 = infExp;
+        mantissa = 0;
+    }
+
+    return mantissa | (std::uint64_t(exp2) << mantissaBits);
+}
+
+/// @brief Computes the `Real` closest to `mW * 10^mQ`.
+/// @details `mTruncated` must be true if `mW` is missing some nonzero
+/// digits of the number. Returns false if the result depends on them.
+inline bool computeReal(std::uint64_t mW, std::int64_t mQ, bool mNegative,
+    bool mTruncated, Real& mResult) noexcept
+{
+    // Clinger's fast path: both `mW` and `10^|mQ|` are exact doubles
+    constexpr Real exactPows10[]{1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+        1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+        1e20, 1e21, 1e22};
+
+    if(!mTruncated && mQ >= -22 && mQ <= 22 &&
+        mW <= (std::uint64_t(1) << 53))
+    {
+        mResult = Real(mW);
+        mResult = mQ < 0 ? mResult / exactPows10[-mQ]
+                         : mResult * exactPows10[mQ];
+        if(mNegative) mResult = -mResult;
+        return true;
+    }
+
+    auto bits(eiselLemire(mW, mQ));
+
+    // The missing digits can at most round `mW` up to `mW + 1`
+    if(mTruncated && bits != eiselLemire(mW + 1, mQ)) return false;
+
+    bits |= std::uint64_t(mNegative) << 63;
+    std::memcpy(&mResult, &bits, sizeof(mResult));
+    return true;
+}
+
+/// @brief Parses the JSON number at the beginning of `[mBegin, mEnd)`,
+/// storing it in `mNum`.
+/// @details Integers are stored as `IntS`, or as `IntU` if they only fit
+/// in the latter. Numbers with a fraction or an exponent, and integers that
+/// do not fit in 64 bits, are stored as correctly rounded `Real`s. Returns
+/// the end of the number, or `mBegin` if there is no valid number.
+inline const char* parseNum(
+    const char* mBegin, const char* mEnd, Num& mNum) noexcept
+{
+    auto p(mBegin);
+    auto isD([&p, mEnd] { return p != mEnd && isDigit(*p); });
+
+    const auto negative(p != mEnd && *p == '-');
+    if(negative) ++p;
+
+    if(!isD()) return mBegin;
+
+    // Integer part
+    const auto intBegin(p);
+    if(*p == '0')
+        ++p;
+    else
+        while(isD()) ++p;
+    const auto intEnd(p);
+
+    // Fraction part
+    const char* fracBegin{p};
+    const char* fracEnd{p};
+    if(p != mEnd && *p == '.')
+    {
+        ++p;
+        if(!isD()) return mBegin;
+
+        fracBegin = p;
+        while(isD()) ++p;
+        fracEnd = p;
+    }
+
+    // Exponent part, saturated to avoid overflow
+    std::int64_t exp10{0};
+    bool hasExp{false};
+    if(p != mEnd && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+
+        auto expNegative(false);
+        if(p != mEnd && (*p == '+' || *p == '-')) expNegative = *p++ == '-';
+        if(!isD()) return mBegin;
+
+        hasExp = true;
+        for(; isD(); ++p)
+            if(exp10 < 1000000) exp10 = exp10 * 10 + (*p - '0');
+
+        if(expNegative) exp10 = -exp10;
+    }
+
+    const auto intDigits(intEnd - intBegin);
+
+    // Integer fast path
+    if(fracBegin == fracEnd && !hasExp && intDigits <= maxExactDigits + 1)
+    {
+        std::uint64_t value{0};
+        auto overflow(false);
+
+        for(auto i(intBegin); i != intEnd; ++i)
+        {
+            const std::uint64_t d(*i - '0');
+            if(value > (std::numeric_limits<std::uint64_t>::max() - d) / 10)
+            {
+                overflow = true;
+                break;
+            }
+
+            value = value * 10 + d;
+        }
+
+        constexpr auto maxIntS(
+            std::uint64_t(std::numeric_limits<IntS>::max()));
+
+        if(!overflow && !negative)
+        {
+            if(value <= maxIntS)
+                mNum = Num{IntS(value)};
+            else
+                mNum = Num{IntU(value)};
+
+            return p;
+        }
+
+        if(!overflow && value <= maxIntS + 1)
+        {
+            // Negating in unsigned arithmetic handles `IntS`'s minimum
+            mNum = Num{IntS(std::uint64_t(0) - value)};
+            return p;
+        }
+    }
+
+    // Collect up to `maxExactDigits` significant digits in `w`
+    std::uint64_t w{0};
+    int taken{0};
+    bool truncated{false};
+    std::int64_t digitPos{0}, posAfterTaken{0};
+
+    auto collect([&](const char* mB, const char* mE) {
+        for(auto i(mB); i != mE; ++i, ++digitPos)
+        {
+            const auto d(*i - '0');
+            if(w == 0 && d == 0) continue;
+
+            if(taken == maxExactDigits)
+            {
+                if(d != 0) truncated = true;
+                continue;
+            }
+
+            w = w * 10 + std::uint64_t(d);
+            ++taken;
+            posAfterTaken = digitPos + 1;
+        }
+    });
+
+    collect(intBegin, intEnd);
+    collect(fracBegin, fracEnd);
+
+    Real result;
+    const auto q(exp10 + intDigits - posAfterTaken);
+
+    if(SSVU_UNLIKELY(!computeReal(w, q, negative, truncated, result)))
+    {
+        // Slow path for ambiguous truncated inputs
+        const auto r(std::from_chars(mBegin, p, result));
+        if(r.ec == std::errc::result_out_of_range)
+        {
+            result = q > 0 ? std::numeric_limits<Real>::infinity() : 0.0;
+            if(negative) result = -result;
+        }
+    }
+
+    mNum = Num{result};
+    return p;
+}
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,92 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_INTERNAL_PARALLEL
+#define SSVU_JSON_IO_INTERNAL_PARALLEL
+
+#include "SSVUtils/Core/Core.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Minimum number of items parsed by a single thread.
+constexpr std::size_t parMinItemsPerThread{256};
+
+/// @brief Returns the number of threads to use for `mItemCount` items,
+/// given a requested number of threads (`0` means "all hardware
+/// threads").
+inline std::size_t getParThreadCount(
+    std::size_t mItemCount, std::size_t mThreads) noexcept
+{
+    if(mThreads == 0) mThreads = std::thread::hardware_concurrency();
+
+    auto maxUseful(mItemCount / parMinItemsPerThread);
+    return std::max(std::size_t(1), std::min(mThreads, maxUseful));
+}
+
+/// @brief Splits `[0, mItemCount)` in `mThreadCount` contiguous ranges,
+/// calling `mF(begin, end)` for each of them on a separate thread.
+/// @details The calling thread processes the first range, and the ranges
+/// of threads that could not be started. The first exception thrown by
+/// `mF` is rethrown once all threads are joined.
+template <typename TF>
+inline void forRangesParallel(
+    std::size_t mItemCount, std::size_t mThreadCount, TF& mF)
+{
+    std::mutex fatalMutex;
+    std::exception_ptr fatal;
+
+    auto work([&](std::size_t mBegin, std::size_t mEnd) {
+        try
+        {
+            mF(mBegin, mEnd);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock{fatalMutex};
+            if(!fatal) fatal = std::current_exception();
+        }
+    });
+
+    std::vector<std::thread> threads;
+    threads.reserve(mThreadCount - 1);
+
+    const auto perThread(mItemCount / mThreadCount);
+    for(auto t(1u); t < mThreadCount; ++t)
+    {
+        auto last(t + 1 == mThreadCount);
+        const auto begin(t * perThread);
+        const auto end(last ? mItemCount : (t + 1) * perThread);
+
+        // Threads that cannot be started leave their range to the calling
+        // thread, as destroying the started ones unjoined would terminate
+        try
+        {
+            threads.emplace_back(work, begin, end);
+        }
+        catch(...)
+        {
+            work(begin, end);
+        }
+    }
+
+    work(0, mThreadCount == 1 ? mItemCount : perThread);
+    for(auto& t : threads) t.join();
+
+    if(fatal) std::rethrow_exception(fatal);
+}
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,137 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_INTERNAL_STRESCAPER
+#define SSVU_JSON_IO_INTERNAL_STRESCAPER
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Io/Internal/StructIdx.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Returns true if `mC` must be escaped in JSON strings.
+inline constexpr bool needsEscape(char mC) noexcept
+{
+    return static_cast<unsigned char>(mC) < 0x20 || mC == '"' || mC == '\\';
+}
+
+/// @brief Returns the index of the first character of `[mP, mP + mSize)`
+/// that must be escaped, or `mSize` if there is none.
+/// @details Clean runs are skipped 32 or 16 characters at a time when AVX2
+/// or SSE2 are available.
+inline std::size_t findEscape(const char* mP, std::size_t mSize) noexcept
+{
+    std::size_t i{0};
+
+#if defined(__AVX2__)
+    {
+        const auto quote(_mm256_set1_epi8('"'));
+        const auto backslash(_mm256_set1_epi8('\\'));
+        const auto ctrlMax(_mm256_set1_epi8(0x1F));
+
+        for(; i + 32 <= mSize; i += 32)
+        {
+            const auto x(_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(mP + i)));
+
+            // Unsigned `x <= 0x1F` is computed as `max(x, 0x1F) == 0x1F`
+            const auto m(_mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(x, quote),
+                    _mm256_cmpeq_epi8(x, backslash)),
+                _mm256_cmpeq_epi8(_mm256_max_epu8(x, ctrlMax), ctrlMax)));
+
+            const auto bits(std::uint32_t(_mm256_movemask_epi8(m)));
+            if(bits != 0) return i + ctz64(bits);
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    {
+        const auto quote(_mm_set1_epi8('"'));
+        const auto backslash(_mm_set1_epi8('\\'));
+        const auto ctrlMax(_mm_set1_epi8(0x1F));
+
+        for(; i + 16 <= mSize; i += 16)
+        {
+            const auto x(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(mP + i)));
+
+            const auto m(_mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+                _mm_cmpeq_epi8(_mm_max_epu8(x, ctrlMax), ctrlMax)));
+
+            const auto bits(std::uint32_t(_mm_movemask_epi8(m)));
+            if(bits != 0) return i + ctz64(bits);
+        }
+    }
+#endif
+
+    for(; i < mSize; ++i)
+        if(needsEscape(mP[i])) return i;
+
+    return mSize;
+}
+
+/// @brief Writes the escape sequence of `mC`, which must need escaping, to
+/// `mSink`.
+template <typename TSink>
+inline void writeEscape(TSink& mSink, char mC)
+{
+    switch(mC)
+    {
+        case '"': mSink.put("\\\""); return;
+        case '\\': mSink.put("\\\\"); return;
+        case '\b': mSink.put("\\b"); return;
+        case '\f': mSink.put("\\f"); return;
+        case '\n': mSink.put("\\n"); return;
+        case '\r': mSink.put("\\r"); return;
+        case '\t': mSink.put("\\t"); return;
+    }
+
+    constexpr const char* hexDigits{"0123456789abcdef"};
+    const auto c(static_cast<unsigned char>(mC));
+    const char buf[]{'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 15]};
+    mSink.put(std::string_view{buf, sizeof(buf)});
+}
+
+/// @brief Writes `mStr` to `mSink`, escaping the characters that need it.
+/// @details Runs of characters that do not need escaping are written at
+/// once.
+template <typename TSink>
+inline void writeEscaped(TSink& mSink, std::string_view mStr)
+{
+    const auto p(mStr.data());
+    const auto size(mStr.size());
+
+    for(std::size_t i{0}; i < size;)
+    {
+        const auto j(i + findEscape(p + i, size - i));
+        if(j != i) mSink.put(std::string_view{p + i, j - i});
+        if(j == size) return;
+
+        writeEscape(mSink, p[j]);
+        i = j + 1;
+    }
+}
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
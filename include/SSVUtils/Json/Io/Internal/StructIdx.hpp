@@ -0,0 +1,319 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_INTERNAL_STRUCTIDX
+#define SSVU_JSON_IO_INTERNAL_STRUCTIDX
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Size of the blocks classified at once by `StructIdx`.
+constexpr std::size_t structIdxBlockSize{64};
+
+/// @brief Size of the source windows indexed at once by `StructIdx`.
+/// @details Small enough for the positions of a window to stay in cache
+/// until they are read.
+constexpr std::size_t structIdxWindowSize{structIdxBlockSize * 256};
+
+/// @brief Bitmasks classifying the characters of a 64-byte block.
+/// @details Bit `i` refers to the `i`-th character of the block.
+struct BlockMasks
+{
+    std::uint64_t quote{0}, backslash{0}, op{0}, ws{0}, slash{0};
+};
+
+/// @brief Returns the index of the lowest set bit of `mX`, which must not
+/// be zero.
+inline unsigned int ctz64(std::uint64_t mX) noexcept
+{
+#if(defined(SSVU_COMPILER_CLANG) || defined(SSVU_COMPILER_GCC))
+    return __builtin_ctzll(mX);
+#else
+    auto result(0u);
+    for(; (mX & 1u) == 0; mX >>= 1) ++result;
+    return result;
+#endif
+}
+
+#if defined(__AVX2__)
+/// @brief Classifies a 64-byte block using two 32-byte AVX2 loads.
+inline BlockMasks classifyBlock(const char* mPtr) noexcept
+{
+    const __m256i chunks[2]{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mPtr)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mPtr + 32))};
+
+    auto eq([&chunks](char mC) {
+        const auto c(_mm256_set1_epi8(mC));
+        const std::uint64_t lo(static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[0], c))));
+        const std::uint64_t hi(static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[1], c))));
+        return lo | (hi << 32);
+    });
+
+    BlockMasks result;
+    result.quote = eq('"');
+    result.backslash = eq('\\');
+    result.op = eq('{') | eq('}') | eq('[') | eq(']') | eq(':') | eq(',');
+    result.ws = eq(' ') | eq('\t') | eq('\n') | eq('\r');
+    result.slash = eq('/');
+    return result;
+}
+#elif defined(__SSE2__)
+/// @brief Classifies a 64-byte block using four 16-byte SSE2 loads.
+inline BlockMasks classifyBlock(const char* mPtr) noexcept
+{
+    const __m128i chunks[4]{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(mPtr)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(mPtr + 16)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(mPtr + 32)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(mPtr + 48))};
+
+    auto eq([&chunks](char mC) {
+        const auto c(_mm_set1_epi8(mC));
+        std::uint64_t result{0};
+        for(auto i(0u); i < 4; ++i)
+            result |= std::uint64_t(static_cast<std::uint16_t>(
+                          _mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], c))))
+                      << (i * 16);
+        return result;
+    });
+
+    BlockMasks result;
+    result.quote = eq('"');
+    result.backslash = eq('\\');
+    result.op = eq('{') | eq('}') | eq('[') | eq(']') | eq(':') | eq(',');
+    result.ws = eq(' ') | eq('\t') | eq('\n') | eq('\r');
+    result.slash = eq('/');
+    return result;
+}
+#else
+/// @brief Classifies a 64-byte block one character at a time.
+inline BlockMasks classifyBlock(const char* mPtr) noexcept
+{
+    BlockMasks result;
+
+    for(auto i(0u); i < structIdxBlockSize; ++i)
+    {
+        const auto bit(std::uint64_t(1u) << i);
+
+        switch(mPtr[i])
+        {
+            case '"': result.quote |= bit; break;
+            case '\\': result.backslash |= bit; break;
+            case '/': result.slash |= bit; break;
+
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',': result.op |= bit; break;
+
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r': result.ws |= bit; break;
+        }
+    }
+
+    return result;
+}
+#endif
+
+/// @brief Index of the positions of all the tokens of a JSON source, built
+/// one window of `structIdxWindowSize` characters at a time.
+/// @details Contains quotes, brackets, colons, commas and the first
+/// character of every other value, skipping string contents and escaped
+/// quotes. The last window is followed by the size of the source as a
+/// sentinel. The index is flagged as invalid as soon as a window contains
+/// comments or ends the source inside a string, in which case that window
+/// and the rest of the source must be read without it.
+class StructIdx
+{
+private:
+    /// @brief Positions of the tokens of the current window.
+    std::vector<std::uint32_t> positions;
+    std::size_t count{0};
+
+    std::string_view src;
+
+    /// @brief Position in `src` of the next window, or past its end once
+    /// the sentinel has been added.
+    std::size_t next{0};
+
+    bool valid{false};
+
+    // State carried over from the previous block
+    bool prevEscaped{false}, prevScalar{false};
+    std::uint64_t prevInStr{0};
+
+    /// @brief Returns the mask of characters escaped by a backslash.
+    inline std::uint64_t findEscaped(std::uint64_t mBackslash) noexcept
+    {
+        std::uint64_t result{0};
+
+        // The first character was escaped by the previous block
+        if(prevEscaped)
+        {
+            result = 1u;
+            mBackslash &= ~std::uint64_t(1u);
+        }
+
+        prevEscaped = false;
+
+        while(mBackslash != 0)
+        {
+            auto i(ctz64(mBackslash));
+            if(i == structIdxBlockSize - 1)
+            {
+                prevEscaped = true;
+                break;
+            }
+
+            // Escaped backslashes do not escape the next character
+            result |= std::uint64_t(1u) << (i + 1);
+            mBackslash &= ~(std::uint64_t(3u) << i);
+        }
+
+        return result;
+    }
+
+    /// @brief Returns the mask of characters inside strings, opening
+    /// quotes included and closing quotes excluded.
+    inline std::uint64_t findInStr(std::uint64_t mQuote) noexcept
+    {
+        // Prefix XOR: every quote toggles the "inside string" state
+        auto result(mQuote);
+        result ^= result << 1;
+        result ^= result << 2;
+        result ^= result << 4;
+        result ^= result << 8;
+        result ^= result << 16;
+        result ^= result << 32;
+        result ^= prevInStr;
+
+        prevInStr = std::uint64_t(0) - (result >> 63);
+        return result;
+    }
+
+    inline void indexBlock(const char* mPtr, std::uint32_t mBase)
+    {
+        const auto bm(classifyBlock(mPtr));
+        const auto quote(bm.quote & ~findEscaped(bm.backslash));
+        const auto inStr(findInStr(quote));
+
+        // Outside of strings, `/` can only begin a comment
+        if((bm.slash & ~inStr) != 0) valid = false;
+
+        // Scalar values (numbers, `true`, `false`, `null`) are indexed by
+        // their first character
+        const auto scalar(~(bm.op | bm.ws | quote | inStr));
+        const auto scalarStart(
+            scalar & ~((scalar << 1) | std::uint64_t(prevScalar)));
+        prevScalar = (scalar >> 63) != 0;
+
+        // `positions` has room for every character of a window, so the
+        // capacity is not checked
+        auto structural((bm.op & ~inStr) | quote | scalarStart);
+        auto out(positions.data() + count);
+        for(; structural != 0; structural &= structural - 1)
+            *out++ = mBase + ctz64(structural);
+
+        count = out - positions.data();
+    }
+
+public:
+    /// @brief Starts indexing `mSrc`, discarding the previous index.
+    /// @details No window is indexed until `fill` is called.
+    inline void start(std::string_view mSrc)
+    {
+        src = mSrc;
+        count = next = 0;
+        prevEscaped = prevScalar = false;
+        prevInStr = 0;
+
+        valid = mSrc.size() < std::numeric_limits<std::uint32_t>::max();
+        if(!valid) return;
+
+        // Room for a window, its padded last block and the sentinel
+        positions.resize(std::min(mSrc.size(), structIdxWindowSize) +
+                         structIdxBlockSize + 1);
+    }
+
+    /// @brief Replaces the current window with the next one.
+    /// @details Returns false if there are no more windows or if the new
+    /// one is invalid. Windows may contain no tokens.
+    inline bool fill() noexcept
+    {
+        count = 0;
+        if(!valid || next > src.size()) return false;
+
+        auto i(next);
+        const auto end(std::min(src.size(), next + structIdxWindowSize));
+
+        for(; i + structIdxBlockSize <= end; i += structIdxBlockSize)
+            indexBlock(src.data() + i, i);
+
+        // Pad the last partial block of the source with whitespace
+        if(i < end)
+        {
+            char tail[structIdxBlockSize];
+            std::memset(tail, ' ', structIdxBlockSize);
+            std::memcpy(tail, src.data() + i, end - i);
+            indexBlock(tail, i);
+        }
+
+        next = end;
+        if(next == src.size())
+        {
+            if(prevInStr != 0) valid = false;
+
+            positions[count++] = std::uint32_t(src.size());
+            ++next;
+        }
+
+        if(!valid) count = 0;
+        return valid;
+    }
+
+    inline bool isValid() const noexcept
+    {
+        return valid;
+    }
+
+    /// @brief Returns the number of tokens of the current window.
+    inline auto getSize() const noexcept
+    {
+        return count;
+    }
+    inline Idx operator[](std::size_t mI) const noexcept
+    {
+        return positions[mI];
+    }
+};
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
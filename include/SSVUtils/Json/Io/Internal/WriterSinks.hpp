@@ -0,0 +1,179 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_INTERNAL_WRITERSINKS
+#define SSVU_JSON_IO_INTERNAL_WRITERSINKS
+
+#include "SSVUtils/Core/Core.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#if defined(SSVU_OS_WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Size of the output buffer of buffered writer sinks.
+constexpr std::size_t writerBufSize{64 * 1024};
+
+/// @brief Writer sink that appends directly to a string.
+class StrSink
+{
+private:
+    std::string& out;
+
+public:
+    inline StrSink(std::string& mOut) noexcept : out{mOut}
+    {
+    }
+
+    inline void put(std::string_view mStr)
+    {
+        out.append(mStr.data(), mStr.size());
+    }
+    inline void put(char mC)
+    {
+        out.push_back(mC);
+    }
+    inline bool flush() noexcept
+    {
+        return true;
+    }
+};
+
+/// @brief Writer sink that accumulates output in a fixed-size buffer,
+/// passing it to `TFlush` whenever it fills.
+/// @details `TFlush` is called with a pointer and a size, and returns
+/// false on failure. After a failure, further output is discarded. The
+/// buffer must be flushed explicitly once writing is done.
+template <typename TFlush>
+class BufSink
+{
+private:
+    TFlush flushFn;
+    std::unique_ptr<char[]> buf{new char[writerBufSize]};
+    std::size_t size{0};
+    bool good{true};
+
+    inline void flushData(const char* mData, std::size_t mSize)
+    {
+        if(good && mSize > 0) good = flushFn(mData, mSize);
+    }
+
+public:
+    inline BufSink(TFlush mFlushFn) : flushFn{mFlushFn}
+    {
+    }
+
+    BufSink(const BufSink&) = delete;
+    BufSink& operator=(const BufSink&) = delete;
+
+    inline void put(std::string_view mStr)
+    {
+        if(SSVU_UNLIKELY(mStr.size() > writerBufSize - size))
+        {
+            flush();
+
+            // Strings that cannot fit are flushed without being buffered
+            if(mStr.size() >= writerBufSize)
+            {
+                flushData(mStr.data(), mStr.size());
+                return;
+            }
+        }
+
+        std::memcpy(buf.get() + size, mStr.data(), mStr.size());
+        size += mStr.size();
+    }
+    inline void put(char mC)
+    {
+        if(SSVU_UNLIKELY(size == writerBufSize)) flush();
+        buf[size++] = mC;
+    }
+
+    /// @brief Flushes the buffered output, returning false if any flush
+    /// failed.
+    inline bool flush()
+    {
+        flushData(buf.get(), size);
+        size = 0;
+        return good;
+    }
+};
+
+/// @brief Flushes buffered output to an `std::ostream`.
+struct StreamFlush
+{
+    std::ostream* stream;
+
+    inline bool operator()(const char* mData, std::size_t mSize)
+    {
+        stream->write(mData, mSize);
+        return static_cast<bool>(*stream);
+    }
+};
+
+/// @brief Flushes buffered output to a C `FILE`.
+struct CFileFlush
+{
+    std::FILE* file;
+
+    inline bool operator()(const char* mData, std::size_t mSize) noexcept
+    {
+        return std::fwrite(mData, 1, mSize, file) == mSize;
+    }
+};
+
+/// @brief Flushes buffered output to a file descriptor, retrying partial
+/// and interrupted writes.
+struct FdFlush
+{
+    int fd;
+
+    inline bool operator()(const char* mData, std::size_t mSize) noexcept
+    {
+        while(mSize > 0)
+        {
+#if defined(SSVU_OS_WINDOWS)
+            const auto n(::_write(fd, mData, unsigned(mSize)));
+#else
+            const auto n(::write(fd, mData, mSize));
+#endif
+
+            if(n < 0)
+            {
+                if(errno == EINTR) continue;
+                return false;
+            }
+
+            mData += n;
+            mSize -= std::size_t(n);
+        }
+
+        return true;
+    }
+};
+
+using StreamSink = BufSink<StreamFlush>;
+using CFileSink = BufSink<CFileFlush>;
+using FdSink = BufSink<FdFlush>;
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -9,6 +9,7 @@
 #include "SSVUtils/Json/Io/ReadException.hpp"
 #include "SSVUtils/Json/Io/Reader.hpp"
 #include "SSVUtils/Json/Io/Writer.hpp"
+#include "SSVUtils/Json/Io/ChunkReader.hpp"
 
 namespace ssvu
 {
@@ -16,12 +17,12 @@ namespace Json
 {
 namespace Impl
 {
-template <typename TRS>
-inline bool tryParse(Val& mVal, Reader<TRS>& mReader)
+template <typename TF>
+inline bool tryRead(TF&& mF)
 {
     try
     {
-        mVal = mReader.parseVal();
+        mF();
     }
     catch(const ReadException& mEx)
     {
@@ -33,7 +34,41 @@ inline bool tryParse(Val& mVal, Reader<TRS>& mReader)
 
     return true;
 }
+
+template <typename TRS, bool THashedObj, bool TCow>
+inline bool tryParse(ValImpl<THashedObj, TCow>& mVal, Reader<TRS>& mReader)
+{
+    return tryRead([&] {
+        mVal = mReader.template parseVal<ValImpl<THashedObj, TCow>>();
+    });
+}
+
+template <typename TRS, typename TH>
+inline bool tryParseSax(TH& mHandler, Reader<TRS>& mReader)
+{
+    return tryRead([&] { mReader.parse(mHandler); });
+}
 } // namespace Impl
+
+/// @brief Reads `mStr`, forwarding reading events to `mHandler` without
+/// building a `Val` tree.
+/// @details `TH` is expected to provide the same interface as `SaxHandler`.
+/// Returns `false` if a reading error occurred.
+template <typename TRS = RSDefault, typename T, typename TH>
+inline bool saxFromStr(T&& mStr, TH& mHandler)
+{
+    Impl::Reader<TRS> r{FWD(mStr)};
+    return Impl::tryParseSax<TRS>(mHandler, r);
+}
+
+/// @brief Reads the file at `mPath`, forwarding reading events to
+/// `mHandler` without building a `Val` tree.
+template <typename TRS = RSDefault, typename TH>
+inline bool saxFromFile(const ssvufs::Path& mPath, TH& mHandler)
+{
+    const ssvufs::MappedFile file{mPath};
+    return saxFromStr<TRS>(file.getView(), mHandler);
+}
 } // namespace Json
 } // namespace ssvu
 
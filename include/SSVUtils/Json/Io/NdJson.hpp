@@ -0,0 +1,206 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_NDJSON
+#define SSVU_JSON_IO_NDJSON
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/ReadException.hpp"
+#include "SSVUtils/Json/Io/Reader.hpp"
+#include "SSVUtils/Json/Io/Writer.hpp"
+#include "SSVUtils/Json/Io/Internal/Parallel.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Returns the non-blank lines of `mSrc`.
+inline auto splitNdRecords(std::string_view mSrc)
+{
+    std::vector<std::string_view> result;
+    result.reserve(mSrc.size() / 128);
+
+    for(std::size_t i{0}; i < mSrc.size();)
+    {
+        auto nl(static_cast<const char*>(
+            std::memchr(mSrc.data() + i, '\n', mSrc.size() - i)));
+        auto end(nl == nullptr ? mSrc.size() : Idx(nl - mSrc.data()));
+
+        auto line(mSrc.substr(i, end - i));
+        if(std::any_of(std::begin(line), std::end(line),
+               [](char mC) { return !isWhitespace(mC); }))
+            result.emplace_back(line);
+
+        i = end + 1;
+    }
+
+    return result;
+}
+
+/// @brief Parses `mRecords` on up to `mThreads` threads, calling
+/// `mF(recordIdx, Val&&)` for every successfully parsed record.
+/// @details Every thread parses a contiguous range of records. Returns
+/// `false` if any record could not be parsed, logging the first error.
+template <typename TRS, typename TF>
+inline bool parseNdRecords(const std::vector<std::string_view>& mRecords,
+    TF& mF, std::size_t mThreads)
+{
+    const auto threadCount(getParThreadCount(mRecords.size(), mThreads));
+
+    std::mutex errorMutex;
+    std::size_t errorRecord{mRecords.size()};
+    std::string errorTitle, errorWhat, errorSrc;
+
+    auto work([&](std::size_t mBegin, std::size_t mEnd) {
+        for(auto i(mBegin); i < mEnd; ++i)
+        {
+            try
+            {
+                Reader<TRS> r{mRecords[i]};
+                auto v(r.parseVal());
+
+                // Every line must contain exactly one value
+                r.expectEnd();
+                mF(i, std::move(v));
+            }
+            catch(const ReadException& mEx)
+            {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if(i >= errorRecord) continue;
+
+                errorRecord = i;
+                errorTitle = mEx.getTitle();
+                errorWhat = mEx.what();
+                errorSrc = mEx.getSrc();
+            }
+        }
+    });
+
+    forRangesParallel(mRecords.size(), threadCount, work);
+
+    if(errorRecord == mRecords.size()) return true;
+
+    lo("JSON") << "Error occured during read of record " << errorRecord
+               << "\n";
+    lo(errorTitle) << errorWhat << " - at:\n" + errorSrc << std::endl;
+    return false;
+}
+} // namespace Impl
+
+/// @brief Reads the newline-delimited JSON records of `mSrc`, calling
+/// `mF(recordIdx, Val&&)` for every record.
+/// @details Records are parsed on up to `mThreads` threads (`0` means "all
+/// hardware threads"), so `mF` may be called concurrently and in any order.
+/// Blank lines are skipped and not counted. Returns `false` if any record
+/// could not be parsed or is followed by another value on the same line.
+template <typename TRS = RSInSitu, typename TF>
+inline bool forRecordsNd(
+    std::string_view mSrc, TF&& mF, std::size_t mThreads = 0)
+{
+    const auto records(Impl::splitNdRecords(mSrc));
+    return Impl::parseNdRecords<TRS>(records, mF, mThreads);
+}
+
+/// @brief Returns the newline-delimited JSON records of `mSrc`, parsed on
+/// up to `mThreads` threads.
+/// @details Records that could not be parsed are left null.
+template <typename TRS = RSInSitu>
+inline auto fromStrNd(std::string_view mSrc, std::size_t mThreads = 0)
+{
+    const auto records(Impl::splitNdRecords(mSrc));
+    std::vector<Val> result(records.size());
+
+    auto store([&result](std::size_t mIdx, Val&& mVal) {
+        result[mIdx] = std::move(mVal);
+    });
+
+    Impl::parseNdRecords<TRS>(records, store, mThreads);
+    return result;
+}
+
+/// @brief Returns the newline-delimited JSON records of the file in
+/// `mPath`, parsed on up to `mThreads` threads.
+template <typename TRS = RSInSitu>
+inline auto fromFileNd(const ssvufs::Path& mPath, std::size_t mThreads = 0)
+{
+    const ssvufs::MappedFile file{mPath};
+    return fromStrNd<TRS>(file.getView(), mThreads);
+}
+
+namespace Impl
+{
+/// @brief Writes the values of `mVals` to `mSink`, one per line, and
+/// flushes it.
+template <typename TWS, typename TSink, typename TC>
+inline bool writeToSinkNd(TSink& mSink, const TC& mVals)
+{
+    static_assert(!TWS::pretty, "Records must not contain newlines");
+
+    Writer<TWS, TSink> w{mSink};
+    for(const auto& v : mVals)
+    {
+        w.write(v);
+        mSink.put('\n');
+    }
+
+    return mSink.flush();
+}
+} // namespace Impl
+
+/// @brief Writes the values of `mVals` to `mStream`, one per line.
+template <typename TWS = WSMinified, typename TC>
+inline void writeToStreamNd(std::ostream& mStream, const TC& mVals)
+{
+    Impl::StreamSink s{{&mStream}};
+    Impl::writeToSinkNd<TWS>(s, mVals);
+    mStream.flush();
+}
+
+/// @brief Writes the values of `mVals` to `mStr`, one per line.
+template <typename TWS = WSMinified, typename TC>
+inline void writeToStrNd(std::string& mStr, const TC& mVals)
+{
+    mStr.clear();
+    Impl::StrSink s{mStr};
+    Impl::writeToSinkNd<TWS>(s, mVals);
+}
+
+/// @brief Writes the values of `mVals` to the file in `mPath`, one per
+/// line.
+template <typename TWS = WSMinified, typename TC>
+inline bool writeToFileNd(const ssvufs::Path& mPath, const TC& mVals)
+{
+    auto file(std::fopen(mPath.getCStr(), "wb"));
+    if(file == nullptr) return false;
+
+    Impl::CFileSink s{{file}};
+    const auto result(Impl::writeToSinkNd<TWS>(s, mVals));
+    return std::fclose(file) == 0 && result;
+}
+
+/// @brief Returns a string containing the values of `mVals`, one per line.
+template <typename TWS = WSMinified, typename TC>
+inline auto getWriteToStrNd(const TC& mVals)
+{
+    std::string result;
+    writeToStrNd<TWS>(result, mVals);
+    return result;
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,188 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_PARALLELARR
+#define SSVU_JSON_IO_PARALLELARR
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/ReadException.hpp"
+#include "SSVUtils/Json/Io/Reader.hpp"
+#include "SSVUtils/Json/Io/ValBuilder.hpp"
+#include "SSVUtils/Json/Io/Internal/Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Appends the source of every element of the top-level array in
+/// `mSrc` to `mOut`.
+/// @details Only tracks bracket depth, skipping strings and comments:
+/// elements are not validated. Returns `false` if `mSrc` is not an array
+/// or its brackets are unbalanced.
+inline bool splitArrElements(
+    std::string_view mSrc, std::vector<std::string_view>& mOut)
+{
+    const auto size(mSrc.size());
+    Idx i{0};
+
+    auto skipComment([&] {
+        while(i + 1 < size && mSrc[i + 1] != '\n') ++i;
+    });
+
+    // Find the opening '['
+    for(; i < size && mSrc[i] != '['; ++i)
+    {
+        if(mSrc[i] == '/' && i + 1 < size && mSrc[i + 1] == '/')
+            skipComment();
+        else if(!isWhitespace(mSrc[i]))
+            return false;
+    }
+
+    std::size_t depth{0};
+    auto begin(++i);
+
+    for(; i < size; ++i)
+    {
+        switch(mSrc[i])
+        {
+            case '"':
+                for(++i; i < size && mSrc[i] != '"'; ++i)
+                    if(mSrc[i] == '\\') ++i;
+
+                if(i >= size) return false;
+                break;
+
+            case '/':
+                if(i + 1 < size && mSrc[i + 1] == '/') skipComment();
+                break;
+
+            case '[':
+            case '{': ++depth; break;
+
+            case '}':
+                if(depth == 0) return false;
+                --depth;
+                break;
+
+            case ']':
+                if(depth > 0)
+                {
+                    --depth;
+                    break;
+                }
+
+                // Empty arrays have no elements
+                if(!mOut.empty() ||
+                    std::any_of(mSrc.data() + begin, mSrc.data() + i,
+                        [](char mC) { return !isWhitespace(mC); }))
+                    mOut.emplace_back(mSrc.substr(begin, i - begin));
+
+                return true;
+
+            case ',':
+                if(depth > 0) break;
+
+                mOut.emplace_back(mSrc.substr(begin, i - begin));
+                begin = i + 1;
+                break;
+        }
+    }
+
+    return false;
+}
+
+/// @brief Parses `mElements` on `mThreadCount` threads, storing them in
+/// `mArr`, which must have the same size.
+/// @details Returns `false` if any element is not a single valid value.
+template <typename TRS>
+inline bool parseArrElements(const std::vector<std::string_view>& mElements,
+    Arr& mArr, std::size_t mThreadCount)
+{
+    std::atomic<bool> failed{false};
+
+    auto work([&](std::size_t mBegin, std::size_t mEnd) {
+        for(auto i(mBegin); i < mEnd; ++i)
+        {
+            if(failed.load(std::memory_order_relaxed)) return;
+
+            try
+            {
+                Reader<TRS> r{mElements[i]};
+                mArr[i] = r.parseVal();
+
+                if(SSVU_UNLIKELY(!r.isAtEnd())) failed = true;
+            }
+            catch(const ReadException&)
+            {
+                failed = true;
+            }
+        }
+    });
+
+    forRangesParallel(mElements.size(), mThreadCount, work);
+    return !failed;
+}
+} // namespace Impl
+
+/// @brief Returns a JSON value constructed from the string `mSrc`. The
+/// elements of a top-level array are parsed on up to `mThreads` threads
+/// (`0` means "all hardware threads").
+/// @details Element boundaries are found with a quick scan, then every
+/// element is parsed separately into a presized `Arr`. Small arrays and
+/// other values are parsed serially. The result is always the same as
+/// `fromStr`'s: if any element cannot be parsed, the whole source is
+/// parsed again serially to report the error.
+template <typename TRS = RSDefault>
+inline auto fromStrParallel(std::string_view mSrc, std::size_t mThreads = 0)
+{
+    if(mThreads == 0) mThreads = std::thread::hardware_concurrency();
+
+    std::vector<std::string_view> elements;
+    if(mThreads > 1 && Impl::splitArrElements(mSrc, elements))
+    {
+        const auto threadCount(
+            Impl::getParThreadCount(elements.size(), mThreads));
+
+        if(threadCount > 1)
+        {
+            Impl::Arr arr(elements.size());
+            if(Impl::parseArrElements<TRS>(elements, arr, threadCount))
+            {
+                Val result;
+                if(!TRS::numArrs ||
+                    !Impl::tryPackNumArr(
+                        std::begin(arr), std::end(arr), result))
+                    result = std::move(arr);
+
+                return result;
+            }
+        }
+    }
+
+    return Val::fromStr<TRS>(mSrc);
+}
+
+/// @brief Returns a JSON value constructed from the file in `mPath`. The
+/// elements of a top-level array are parsed on up to `mThreads` threads.
+template <typename TRS = RSDefault>
+inline auto fromFileParallel(
+    const ssvufs::Path& mPath, std::size_t mThreads = 0)
+{
+    const ssvufs::MappedFile file{mPath};
+    return fromStrParallel<TRS>(file.getView(), mThreads);
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,181 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_POINTER
+#define SSVU_JSON_IO_POINTER
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/Io.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Appends `/` and the RFC 6901 escaped `mToken` to `mOut`.
+inline void appendPointerToken(std::string& mOut, std::string_view mToken)
+{
+    mOut += '/';
+
+    for(auto c : mToken)
+    {
+        if(c == '~')
+            mOut += "~0";
+        else if(c == '/')
+            mOut += "~1";
+        else
+            mOut += c;
+    }
+}
+} // namespace Impl
+
+/// @brief Location of a value inside a JSON document.
+/// @details Every token is either an object key or, when the enclosing
+/// value is an array, a decimal index.
+class Pointer
+{
+private:
+    std::vector<std::string> tokens;
+
+public:
+    inline Pointer() = default;
+    inline Pointer(std::vector<std::string> mTokens) noexcept
+        : tokens{std::move(mTokens)}
+    {
+    }
+
+    /// @brief Returns the pointer described by the RFC 6901 string `mStr`,
+    /// such as `"/renderer/shadows/0"`.
+    /// @details `~1` and `~0` are unescaped to `/` and `~`. An empty string
+    /// points to the whole document.
+    inline static Pointer fromStr(std::string_view mStr)
+    {
+        Pointer result;
+        if(mStr.empty()) return result;
+
+        if(mStr[0] != '/')
+            throw std::runtime_error{"JSON pointer `" + std::string{mStr} +
+                                     "' must begin with `/'"};
+
+        for(auto i(1u); true; ++i)
+        {
+            auto& token(result.tokens.emplace_back());
+
+            for(; i < mStr.size() && mStr[i] != '/'; ++i)
+            {
+                if(mStr[i] != '~')
+                {
+                    token += mStr[i];
+                    continue;
+                }
+
+                const auto next(i + 1 < mStr.size() ? mStr[i + 1] : '\0');
+                if(next != '0' && next != '1')
+                    throw std::runtime_error{
+                        "Invalid escape in JSON pointer `" +
+                        std::string{mStr} + "'"};
+
+                token += next == '0' ? '~' : '/';
+                ++i;
+            }
+
+            if(i >= mStr.size()) return result;
+        }
+    }
+
+    /// @brief Returns the pointer described by the dot-separated path
+    /// `mPath`, such as `"renderer.shadows.0"`.
+    /// @details Keys containing dots cannot be represented. An empty string
+    /// points to the whole document.
+    inline static Pointer fromPath(std::string_view mPath)
+    {
+        Pointer result;
+        if(mPath.empty()) return result;
+
+        for(std::size_t i{0}; true;)
+        {
+            const auto dot(std::min(mPath.find('.', i), mPath.size()));
+            result.tokens.emplace_back(mPath.substr(i, dot - i));
+
+            if(dot == mPath.size()) return result;
+            i = dot + 1;
+        }
+    }
+
+    /// @brief Returns the RFC 6901 string describing the pointer.
+    inline auto toStr() const
+    {
+        std::string result;
+        for(const auto& t : tokens) Impl::appendPointerToken(result, t);
+        return result;
+    }
+
+    inline const auto& getTokens() const noexcept
+    {
+        return tokens;
+    }
+};
+
+/// @brief Reads only the value at `mPointer` in `mStr` into `mOut`.
+/// @details Unrelated values are skipped by bracket matching, without being
+/// validated or allocated. Returns `false` if the value does not exist or a
+/// reading error occurred, leaving `mOut` untouched.
+template <typename TRS = RSInSitu, typename T>
+inline bool queryFromStr(T&& mStr, const Pointer& mPointer, Val& mOut)
+{
+    Impl::Reader<TRS> r{FWD(mStr)};
+    bool found{false};
+
+    Impl::tryRead([&] {
+        if(!r.seek(mPointer.getTokens())) return;
+
+        mOut = r.parseVal();
+        found = true;
+    });
+
+    return found;
+}
+
+/// @brief Reads only the value at `mPointer` in the file in `mPath` into
+/// `mOut`.
+template <typename TRS = RSInSitu>
+inline bool queryFromFile(
+    const ssvufs::Path& mPath, const Pointer& mPointer, Val& mOut)
+{
+    const ssvufs::MappedFile file{mPath};
+    return queryFromStr<TRS>(file.getView(), mPointer, mOut);
+}
+
+/// @brief Returns the value at `mPointer` in `mStr`, or a null value if it
+/// does not exist.
+template <typename TRS = RSInSitu, typename T>
+inline auto queryStr(T&& mStr, const Pointer& mPointer)
+{
+    Val result;
+    queryFromStr<TRS>(FWD(mStr), mPointer, result);
+    return result;
+}
+
+/// @brief Returns the value at `mPointer` in the file in `mPath`, or a null
+/// value if it does not exist.
+template <typename TRS = RSInSitu>
+inline auto queryFile(const ssvufs::Path& mPath, const Pointer& mPointer)
+{
+    Val result;
+    queryFromFile<TRS>(mPath, mPointer, result);
+    return result;
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -9,9 +9,17 @@
 #include "SSVUtils/Json/Common/Common.hpp"
 #include "SSVUtils/Json/Val/Val.hpp"
 #include "SSVUtils/Json/Io/ReadException.hpp"
+#include "SSVUtils/Json/Io/Internal/NumParser.hpp"
+#include "SSVUtils/Json/Io/Internal/StructIdx.hpp"
+#include "SSVUtils/Json/Io/SaxHandler.hpp"
+#include "SSVUtils/Json/Io/ValBuilder.hpp"
 
+#include <charconv>
 #include <string>
+#include <string_view>
+#include <cstring>
 #include <cassert>
+#include <type_traits>
 
 namespace ssvu
 {
@@ -22,12 +30,12 @@ namespace Impl
 inline bool isValidEscapeSequenceChar(char mC) noexcept
 {
     return mC == '"' || mC == '\\' || mC == '/' || mC == 'b' || mC == 'f' ||
-           mC == 'n' || mC == 'r' || mC == 't';
+           mC == 'n' || mC == 'r' || mC == 't' || mC == 'u';
 }
 
 inline char getEscapeSequence(char mC) noexcept
 {
-    assert(isValidEscapeSequenceChar(mC));
+    assert(isValidEscapeSequenceChar(mC) && mC != 'u');
 
     switch(mC)
     {
@@ -44,61 +52,302 @@ inline char getEscapeSequence(char mC) noexcept
     }
 }
 
+inline constexpr bool isWhitespace(char mC) noexcept
+{
+    return mC == ' ' || mC == '\t' || mC == '\r' || mC == '\n';
+}
+inline constexpr bool isNumStart(char mC) noexcept
+{
+    return mC == '-' || isDigit(mC);
+}
+inline bool isNumChar(char mC) noexcept
+{
+    return isDigit(mC) || mC == '-' || mC == '+' || mC == '.' || mC == 'e' ||
+           mC == 'E';
+}
+
+/// @brief Returns the value of the hexadecimal digit `mC`, or `-1`.
+inline constexpr int getHexDigitVal(char mC) noexcept
+{
+    if(mC >= '0' && mC <= '9') return mC - '0';
+    if(mC >= 'a' && mC <= 'f') return mC - 'a' + 10;
+    if(mC >= 'A' && mC <= 'F') return mC - 'A' + 10;
+    return -1;
+}
+
+/// @brief Reads the four hexadecimal digits starting at `mP`, returning
+/// `-1` if they are not valid.
+inline long readHex4(const char* mP) noexcept
+{
+    long result{0};
+    for(auto i(0); i < 4; ++i)
+    {
+        const auto d(getHexDigitVal(mP[i]));
+        if(d < 0) return -1;
+        result = result * 16 + d;
+    }
+
+    return result;
+}
+
+/// @brief Returns true if all escape sequences of the raw string `mRaw`
+/// are valid.
+inline bool areEscapesValid(std::string_view mRaw) noexcept
+{
+    for(std::size_t i{0}; i < mRaw.size(); ++i)
+    {
+        if(mRaw[i] != '\\') continue;
+        if(++i == mRaw.size() || !isValidEscapeSequenceChar(mRaw[i]))
+            return false;
+
+        if(mRaw[i] != 'u') continue;
+        if(mRaw.size() - i <= 4 || readHex4(mRaw.data() + i + 1) < 0)
+            return false;
+
+        i += 4;
+    }
+
+    return true;
+}
+
+/// @brief Appends the UTF-8 encoding of the code point `mCP` to `mOut`.
+inline void appendUtf8(std::string& mOut, unsigned long mCP)
+{
+    if(mCP < 0x80)
+        mOut += char(mCP);
+    else if(mCP < 0x800)
+    {
+        mOut += char(0xC0 | (mCP >> 6));
+        mOut += char(0x80 | (mCP & 0x3F));
+    }
+    else if(mCP < 0x10000)
+    {
+        mOut += char(0xE0 | (mCP >> 12));
+        mOut += char(0x80 | ((mCP >> 6) & 0x3F));
+        mOut += char(0x80 | (mCP & 0x3F));
+    }
+    else
+    {
+        mOut += char(0xF0 | (mCP >> 18));
+        mOut += char(0x80 | ((mCP >> 12) & 0x3F));
+        mOut += char(0x80 | ((mCP >> 6) & 0x3F));
+        mOut += char(0x80 | (mCP & 0x3F));
+    }
+}
+
+/// @brief Decodes the `\\uXXXX` escape sequence whose digits start at
+/// index `mI` of `mRaw`, combining it with a following low surrogate
+/// escape if needed, and appends it to `mOut` as UTF-8.
+/// @details Returns the index after the decoded sequence. Unpaired
+/// surrogates are replaced with U+FFFD.
+inline std::size_t unescapeUtf16(
+    std::string_view mRaw, std::size_t mI, std::string& mOut)
+{
+    constexpr unsigned long replacement{0xFFFD};
+
+    const auto cp(static_cast<unsigned long>(readHex4(mRaw.data() + mI)));
+    mI += 4;
+
+    if(cp < 0xD800 || cp > 0xDFFF)
+    {
+        appendUtf8(mOut, cp);
+        return mI;
+    }
+
+    // High surrogate, which must be followed by an escaped low surrogate
+    if(cp <= 0xDBFF && mRaw.size() - mI >= 6 && mRaw[mI] == '\\' &&
+        mRaw[mI + 1] == 'u')
+    {
+        // Invalid digits wrap around and fail the range check
+        const auto low(
+            static_cast<unsigned long>(readHex4(mRaw.data() + mI + 2)));
+        if(low >= 0xDC00 && low <= 0xDFFF)
+        {
+            appendUtf8(mOut, 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00));
+            return mI + 6;
+        }
+    }
+
+    appendUtf8(mOut, replacement);
+    return mI;
+}
+
+/// @brief Unescapes the raw string `mRaw` into `mOut`.
+/// @details The escape sequences of `mRaw` must be valid.
+inline void unescapeStr(std::string_view mRaw, std::string& mOut)
+{
+    assert(areEscapesValid(mRaw));
+
+    mOut.clear();
+    mOut.reserve(mRaw.size());
+
+    for(std::size_t i{0}; i < mRaw.size();)
+    {
+        // Copy everything up to the next escape sequence at once
+        auto escape(static_cast<const char*>(
+            std::memchr(mRaw.data() + i, '\\', mRaw.size() - i)));
+        auto runEnd(
+            escape == nullptr ? mRaw.size() : Idx(escape - mRaw.data()));
+
+        mOut.append(mRaw.data() + i, runEnd - i);
+        if(runEnd == mRaw.size()) return;
+
+        // Escape sequence: skip '\' and convert it
+        if(mRaw[runEnd + 1] == 'u')
+        {
+            i = unescapeUtf16(mRaw, runEnd + 2, mOut);
+            continue;
+        }
+
+        mOut += getEscapeSequence(mRaw[runEnd + 1]);
+        i = runEnd + 2;
+    }
+}
+
+/// @brief Converts the number at the beginning of `mStr`, storing it in
+/// `mNum`.
+/// @details Returns the number of characters read, or zero if `mStr` does
+/// not begin with a number.
+inline std::size_t strToNum(std::string_view mStr, Num& mNum) noexcept
+{
+    const auto begin(mStr.data());
+    return parseNum(begin, begin + mStr.size(), mNum) - begin;
+}
+
+/// @brief Converts the array index `mToken` of a path, storing it in
+/// `mIdx`.
+/// @details Returns false unless `mToken` is a decimal number without
+/// leading zeros, as required by RFC 6901.
+inline bool parseIdxToken(std::string_view mToken, Idx& mIdx) noexcept
+{
+    if(mToken.empty() || (mToken.size() > 1 && mToken[0] == '0'))
+        return false;
+
+    const auto end(mToken.data() + mToken.size());
+    return std::from_chars(mToken.data(), end, mIdx).ptr == end;
+}
+
 template <typename TRS = RSDefault>
 class Reader
 {
+    static_assert(!TRS::indexed || TRS::inSitu,
+        "Indexed reading requires in-situ reading");
+
 private:
-    std::string src;
-    Idx idx{0u}, realSize{0u};
+    /// @brief Owned copy of the source, purged of whitespace and comments.
+    /// @details Unused when `TRS::inSitu` is true.
+    std::string buf;
+
+    /// @brief Characters being parsed.
+    std::string_view src;
+
+    Idx idx{0u};
+
+    /// @brief Positions of all tokens in `src`.
+    /// @details Only built when `TRS::indexed` is true.
+    StructIdx sIdx;
+
+    /// @brief Storage for unescaped strings.
+    std::string strBuf;
+
+    /// @brief Position in the current window of `sIdx` of the next token
+    /// to read.
+    std::size_t sCursor{0u};
+
+    /// @brief True until `sIdx` runs into a window it cannot index.
+    bool useIdx{false};
+
+    /// @brief True while `parse` reads tokens from `sIdx`.
+    /// @details Other reading functions read characters, as they may move
+    /// `idx` without going through the tokens.
+    bool tokMode{false};
+
+    inline bool isTokMode() const noexcept
+    {
+        return TRS::indexed && tokMode;
+    }
 
     inline void throwError(std::string mTitle, std::string mBody)
     {
         throw ReadException{std::move(mTitle), std::move(mBody), getErrorSrc()};
     }
 
-    inline void purgeSource()
+    /// @brief Copies `mIn` to `buf`, purged of whitespace and comments.
+    /// @details `buf` must be at least as big as `mIn`, which can also view
+    /// `buf` itself.
+    inline void purgeSource(std::string_view mIn)
     {
+        const auto in(mIn.data());
+        const auto size(mIn.size());
+        auto out(buf.data());
+
         auto pi(0u);
-        for(auto i(0u); i < src.size(); ++i)
+        for(auto i(0u); i < size; ++i)
         {
             // Skip strings
-            if(getC(i) == '"')
+            if(in[i] == '"')
             {
                 // Skip opening '"'
-                getC(pi++) = getC(i++);
+                out[pi++] = in[i++];
 
-                // Move until closing '"', skipping '\"'
-                while(getC(i) != '"' || getC(i - 1) == '\\')
-                    getC(pi++) = getC(i++);
+                // Move until closing '"', skipping escape sequences
+                while(i < size && in[i] != '"')
+                {
+                    if(in[i] == '\\' && i + 1 < size) out[pi++] = in[i++];
+
+                    out[pi++] = in[i++];
+                }
 
                 // Add and skip closing '"' by continuing
-                getC(pi++) = getC(i);
+                if(i < size) out[pi++] = in[i];
                 continue;
             }
 
             // Detect C++-style comment
-            if(getC(i) == '/' && getC(i + 1) == '/')
+            if(in[i] == '/' && i + 1 < size && in[i + 1] == '/')
             {
-                while(getC(i) != '\n') ++i;
+                while(i < size && in[i] != '\n') ++i;
                 continue;
             }
 
-            if(!isWhitespace(getC(i))) getC(pi++) = getC(i);
+            if(!isWhitespace(in[i])) out[pi++] = in[i];
         }
 
-        realSize = pi;
+        src = std::string_view{buf.data(), pi};
+    }
+
+    /// @brief Skips whitespace and C++-style comments starting at `idx`.
+    /// @details Only required for in-situ parsing, as the source is
+    /// otherwise already purged.
+    inline void skipWS() noexcept
+    {
+        if(!TRS::inSitu) return;
+
+        // Only whitespace can separate tokens
+        if(isTokMode() && fetchTok())
+        {
+            idx = sIdx[sCursor];
+            return;
+        }
+
+        while(true)
+        {
+            while(isWhitespace(getC())) ++idx;
+            if(!isC('/') || getC(idx + 1) != '/') return;
+            while(idx < src.size() && !isC('\n')) ++idx;
+        }
     }
 
     inline auto getErrorSrc()
     {
-        auto intSize(ssvu::toInt(realSize));
-        auto intIdx(ssvu::toInt(idx));
+        auto intSize(ssvu::toInt(src.size()));
+        auto intIdx(std::min(ssvu::toInt(idx), intSize));
 
         auto iStart(std::max(0, intIdx - 20));
-        auto iEnd(std::min(intSize - 1, intIdx + 20));
+        auto iEnd(std::min(intSize, intIdx + 20));
 
         auto iDStart(std::max(0, intIdx - 4));
-        auto iDEnd(std::min(intSize - 1, intIdx + 4));
+        auto iDEnd(std::min(intSize, intIdx + 4));
 
         auto strMarked(
             std::string{std::begin(src) + iStart, std::begin(src) + iDStart} +
@@ -116,38 +365,70 @@ private:
         return strUnmarked + "\n" + strMarked;
     }
 
-    inline static constexpr auto isWhitespace(char mC) noexcept
+    /// @brief Returns the current character, or `'\0'` past the end of
+    /// the source.
+    inline char getC() const noexcept
     {
-        return mC == ' ' || mC == '\t' || mC == '\r' || mC == '\n';
+        return getC(idx);
     }
-    inline static constexpr auto isNumStart(char mC) noexcept
+    inline char getC(std::size_t mIdx) const noexcept
     {
-        return mC == '-' || isDigit(mC);
+        return SSVU_LIKELY(mIdx < src.size()) ? src[mIdx] : '\0';
     }
-
-    inline char& getC() noexcept
+    inline auto isC(char mC) const noexcept
     {
-        assert(idx < src.size());
-        return src[idx];
+        return getC() == mC;
     }
-    inline char getC() const noexcept
+
+    /// @brief Moves to the next window of `sIdx` if the current one has
+    /// been read.
+    /// @details Returns false, leaving token mode for good, if the rest of
+    /// the source cannot be read through the index.
+    inline bool fetchTok() noexcept
     {
-        assert(idx < src.size());
-        return src[idx];
+        while(SSVU_UNLIKELY(sCursor == sIdx.getSize()))
+        {
+            sCursor = 0;
+            if(sIdx.fill()) continue;
+
+            tokMode = useIdx = false;
+            return false;
+        }
+
+        return true;
     }
-    inline char& getC(std::size_t mIdx) noexcept
+
+    /// @brief Skips the single-character token at `idx`.
+    inline void skipTok() noexcept
     {
-        assert(mIdx < src.size());
-        return src[mIdx];
+        ++idx;
+        if(isTokMode()) ++sCursor;
     }
-    inline char getC(std::size_t mIdx) const noexcept
+
+    /// @brief Checks that the number or keyword ending at `idx` is not
+    /// followed by other characters.
+    /// @details Only required when reading tokens, as only the first
+    /// character of scalars is indexed.
+    inline void endScalar()
     {
-        assert(mIdx < src.size());
-        return src[mIdx];
+        if(!isTokMode()) return;
+
+        ++sCursor;
+        if(!fetchTok()) return;
+
+        if(SSVU_UNLIKELY(idx != sIdx[sCursor] && !isWhitespace(getC())))
+            throwError("Invalid value",
+                std::string{"Unexpected `"} + getC() + "` after value");
     }
-    inline auto isC(char mC) const noexcept
+
+    /// @brief Starts reading tokens from `sIdx`, from the next one.
+    inline void beginTokMode() noexcept
     {
-        return getC() == mC;
+        skipWS();
+        tokMode = true;
+
+        // Other reading functions may have moved past some tokens
+        while(fetchTok() && sIdx[sCursor] < idx) ++sCursor;
     }
 
     template <std::size_t TS>
@@ -163,106 +444,500 @@ private:
         }
     }
 
-    inline Str readStr()
+    /// @brief Returns the index of the closing `'"'` of the string
+    /// starting at `idx`.
+    inline Idx findStrEnd()
     {
-        // Skip opening '"'
-        ++idx;
-
-        // Find end index of the string
-        auto end(idx);
-        auto sz(0u);
-        for(; true; ++end, ++sz)
+        for(auto end(idx + 1); true; ++end)
         {
+            if(SSVU_UNLIKELY(end >= src.size()))
+                throwError("Invalid string", "Unterminated string");
+
             // End of the string
-            if(getC(end) == '"') break;
+            if(getC(end) == '"') return end;
 
             // Skip non-escape sequences
             if(getC(end) != '\\') continue;
 
-            // Skip escape sequences
+            // Skip escaped characters, validated by `readStrRaw`
             ++end;
-            assert(isValidEscapeSequenceChar(getC(end)));
         }
+    }
+
+    /// @brief Reads the string starting at `idx`, without unescaping it.
+    /// @details `mEscaped` is set to true if the string contains escape
+    /// sequences. When reading tokens from `sIdx`, the closing quote is the
+    /// next token.
+    inline std::string_view readStrRaw(bool& mEscaped)
+    {
+        // The closing '"' is the token after the opening one
+        if(isTokMode()) ++sCursor;
+        const auto end(
+            isTokMode() && fetchTok() ? Idx(sIdx[sCursor]) : findStrEnd());
+        if(isTokMode()) ++sCursor;
 
-        // Reserve memory for the string (BOTTLENECK)
-        Str result;
-        result.reserve(sz);
+        // Skip opening '"'
+        const auto begin(++idx);
+
+        // Skip closing '"'
+        idx = end + 1;
+
+        const std::string_view result{src.data() + begin, end - begin};
+        mEscaped = std::memchr(result.data(), '\\', result.size()) != nullptr;
+
+        if(SSVU_UNLIKELY(mEscaped && !areEscapesValid(result)))
+            throwError("Invalid string", "Invalid escape sequence");
+
+        return result;
+    }
+
+    /// @brief Reads the string starting at `idx`.
+    /// @details Returns a view into the source if the string contains no
+    /// escape sequences, otherwise a view into an unescaped copy that is
+    /// valid until the next call.
+    inline std::string_view readStr()
+    {
+        bool escaped;
+        const auto raw(readStrRaw(escaped));
+        if(!escaped) return raw;
 
-        for(; idx < end; ++idx)
+        unescapeStr(raw, strBuf);
+        return strBuf;
+    }
+
+    template <typename TH>
+    inline void readKey(TH& mH)
+    {
+        if constexpr(hasOnKeyRaw<TH, void(std::string_view, bool)>())
         {
-            // Not an escape sequence
-            if(!isC('\\'))
+            bool escaped;
+            const auto raw(readStrRaw(escaped));
+            mH.onKeyRaw(raw, escaped);
+        }
+        else
+            mH.onKey(readStr());
+    }
+
+    template <typename TH>
+    inline void readStrVal(TH& mH)
+    {
+        if constexpr(hasOnStrRaw<TH, void(std::string_view, bool)>())
+        {
+            bool escaped;
+            const auto raw(readStrRaw(escaped));
+            mH.onStrRaw(raw, escaped);
+        }
+        else
+            mH.onStr(readStr());
+    }
+
+    inline Num readNum()
+    {
+        Num result;
+        const auto count(strToNum(src.substr(idx), result));
+
+        if(SSVU_UNLIKELY(count == 0))
+            throwError("Invalid number",
+                std::string{"Couldn't parse number beginning with `"} +
+                    getC() + "`");
+
+        idx += count;
+        endScalar();
+        return result;
+    }
+
+    template <typename TH>
+    inline void parseArr(TH& mH)
+    {
+        mH.onArrBegin();
+
+        // Skip '['
+        skipTok();
+        skipWS();
+
+        // Empty array
+        if(isC(']')) goto end;
+
+        while(true)
+        {
+            // Get value
+            parseAny(mH);
+            skipWS();
+
+            // Check for another value
+            if(isC(','))
             {
-                result += getC();
+                skipTok();
                 continue;
             }
 
-            // Escape sequence: skip '\'
-            ++idx;
+            // Check for end of the array
+            if(isC(']')) break;
 
-            // Convert escape sequence
-            result += getEscapeSequence(getC());
+            throwError("Invalid array",
+                std::string{"Expected either `,` or `]`, got `"} + getC() +
+                    "`");
         }
 
-        // Skip closing '"'
-        ++idx;
+    end:
 
-        return result;
+        // Skip ']'
+        skipTok();
+
+        mH.onArrEnd();
     }
 
-    inline Val parseNll()
+    template <typename TH>
+    inline void parseObj(TH& mH)
     {
-        match("null");
-        return Val{Nll{}};
+        mH.onObjBegin();
+
+        // Skip '{'
+        skipTok();
+        skipWS();
+
+        // Empty object
+        if(isC('}')) goto end;
+
+        while(true)
+        {
+            // Read string key
+            skipWS();
+            if(!isC('"'))
+                throwError("Invalid object",
+                    std::string{"Expected `\"` , got `"} + getC() + "`");
+            readKey(mH);
+            skipWS();
+
+            // Read ':'
+            if(!isC(':'))
+                throwError("Invalid object",
+                    std::string{"Expected `:` , got `"} + getC() + "`");
+
+            // Skip ':'
+            skipTok();
+
+            // Read value
+            parseAny(mH);
+            skipWS();
+
+            // Check for another key-value pair
+            if(isC(','))
+            {
+                skipTok();
+                continue;
+            }
+
+            // Check for end of the object
+            if(isC('}')) break;
+
+            throwError("Invalid object",
+                std::string{"Expected either `,` or `}`, got `"} + getC() +
+                    "`");
+        }
+
+    end:
+
+        // Skip '}'
+        skipTok();
+
+        mH.onObjEnd();
     }
-    inline Val parseBlnFalse()
+
+    template <typename TH>
+    inline void parseAny(TH& mH)
     {
-        match("false");
-        return Val{false};
+        skipWS();
+
+        // Check value type
+        switch(getC())
+        {
+            case '{': parseObj(mH); return;
+            case '[': parseArr(mH); return;
+            case '"': readStrVal(mH); return;
+            case 't':
+                match("true");
+                endScalar();
+                mH.onBln(true);
+                return;
+            case 'f':
+                match("false");
+                endScalar();
+                mH.onBln(false);
+                return;
+            case 'n':
+                match("null");
+                endScalar();
+                mH.onNll();
+                return;
+        }
+
+        // Check if value is a number
+        if(isNumStart(getC()))
+        {
+            mH.onNum(readNum());
+            return;
+        }
+
+        throwError("Invalid value",
+            std::string{"No match for values beginning with `"} + getC() + "`");
     }
-    inline Val parseBlnTrue()
+
+    /// @brief Skips the value starting at `idx` by bracket matching.
+    /// @details Only strings and comments are recognized: the skipped value
+    /// is not validated.
+    inline void skipVal()
     {
-        match("true");
-        return Val{true};
+        skipWS();
+
+        std::size_t depth{0};
+        for(; idx < src.size(); ++idx)
+        {
+            switch(src[idx])
+            {
+                case '"':
+                    idx = findStrEnd();
+                    if(depth == 0)
+                    {
+                        ++idx;
+                        return;
+                    }
+                    break;
+
+                case '/':
+                    if(TRS::inSitu && getC(idx + 1) == '/')
+                        while(idx + 1 < src.size() && src[idx + 1] != '\n')
+                            ++idx;
+                    break;
+
+                case '{':
+                case '[': ++depth; break;
+
+                case '}':
+                case ']':
+                    if(depth == 0) return;
+                    if(--depth == 0)
+                    {
+                        ++idx;
+                        return;
+                    }
+                    break;
+
+                case ',':
+                    if(depth == 0) return;
+                    break;
+
+                default:
+                    if(depth == 0 && isWhitespace(src[idx])) return;
+                    break;
+            }
+        }
     }
 
-    inline Val parseNum()
+    /// @brief Moves to the value with key `mKey` of the object starting at
+    /// `idx`, returning false if there is none.
+    inline bool seekKey(std::string_view mKey)
     {
-        char* endChar;
+        // Skip '{'
+        ++idx;
+        skipWS();
+
+        // Empty object
+        if(isC('}')) return false;
 
-        Real realN(toNum<Real>(std::strtod(src.data() + idx, &endChar)));
-        IntS intSN(toNum<IntS>(realN));
+        while(true)
+        {
+            // Read string key
+            skipWS();
+            if(!isC('"'))
+                throwError("Invalid object",
+                    std::string{"Expected `\"` , got `"} + getC() + "`");
+            const auto found(readStr() == mKey);
+            skipWS();
 
-        idx = endChar - src.data();
+            // Read ':'
+            if(!isC(':'))
+                throwError("Invalid object",
+                    std::string{"Expected `:` , got `"} + getC() + "`");
+            ++idx;
+
+            if(found) return true;
+            skipVal();
+            skipWS();
+
+            // Check for another value
+            if(isC(','))
+            {
+                ++idx;
+                continue;
+            }
 
-        auto isDecimal(intSN != realN);
-        if(isDecimal) return Val{Num{realN}};
+            // Check for end of the object
+            if(isC('}')) return false;
 
-        return Val{Num{intSN}};
+            throwError("Invalid object",
+                std::string{"Expected either `,` or `}`, got `"} + getC() +
+                    "`");
+        }
+    }
+
+    /// @brief Moves to the element with decimal index `mIdx` of the array
+    /// starting at `idx`, returning false if there is none.
+    inline bool seekIdx(std::string_view mIdx)
+    {
+        Idx target{0};
+        if(!parseIdxToken(mIdx, target)) return false;
+
+        // Skip '['
+        ++idx;
+        skipWS();
+
+        // Empty array
+        if(isC(']')) return false;
+
+        for(Idx i{0}; i < target; ++i)
+        {
+            skipVal();
+            skipWS();
+
+            // Check for another value
+            if(isC(','))
+            {
+                ++idx;
+                continue;
+            }
+
+            // Check for end of the array
+            if(isC(']')) return false;
+
+            throwError("Invalid array",
+                std::string{"Expected either `,` or `]`, got `"} + getC() +
+                    "`");
+        }
+
+        return true;
     }
 
-    inline Val parseStr()
+public:
+    /// @brief Constructs a reader for `mSrc`.
+    /// @details If `TRS::inSitu` is true, `mSrc` is viewed without being
+    /// copied and must outlive the reader. Otherwise it is purged of
+    /// whitespace and comments, in place if it is an rvalue `std::string`,
+    /// while being copied otherwise.
+    template <typename T>
+    inline Reader(T&& mSrc)
     {
-        return Val{readStr()};
+        if constexpr(TRS::inSitu)
+        {
+            src = std::string_view{mSrc};
+
+            if constexpr(TRS::indexed)
+            {
+                sIdx.start(src);
+                useIdx = sIdx.isValid();
+            }
+        }
+        else if constexpr(std::is_same_v<std::decay_t<T>, std::string> &&
+                          !std::is_lvalue_reference_v<T>)
+        {
+            // Purge owned sources in place
+            buf = std::move(mSrc);
+            purgeSource(buf);
+        }
+        else
+        {
+            // Purge other sources while copying them, so that viewed
+            // sources (such as mapped files) are only read once
+            const std::string_view in{mSrc};
+            buf.resize(in.size());
+            purgeSource(in);
+        }
     }
 
-    inline Val parseArr()
+    /// @brief Reads a single value, forwarding reading events to `mH`.
+    /// @details `TH` is expected to provide the same interface as
+    /// `SaxHandler`. With a valid index, tokens are read from it instead
+    /// of scanning the characters between them.
+    template <typename TH>
+    inline void parse(TH& mH)
     {
-        Arr arr;
+        if constexpr(TRS::indexed)
+            if(useIdx)
+            {
+                beginTokMode();
+                parseAny(mH);
+                tokMode = false;
+                return;
+            }
+
+        parseAny(mH);
+    }
+
+    /// @brief Returns true if only whitespace and comments are left to
+    /// read.
+    inline bool isAtEnd() noexcept
+    {
+        skipWS();
+        return idx >= src.size();
+    }
+
+    /// @brief Throws if anything but whitespace and comments is left to
+    /// read.
+    inline void expectEnd()
+    {
+        if(SSVU_UNLIKELY(!isAtEnd()))
+            throwError("Trailing content",
+                std::string{"Unexpected `"} + getC() + "` after value");
+    }
+
+    /// @brief Moves to the value at `mPath`, skipping unrelated values.
+    /// @details Every token of `mPath` is matched against the keys of an
+    /// object (the first matching key is used) or, for arrays, read as a
+    /// decimal index without leading zeros. Returns false if there is no
+    /// such value.
+    template <typename TC>
+    inline bool seek(const TC& mPath)
+    {
+        for(const auto& t : mPath)
+        {
+            skipWS();
+
+            if(isC('{'))
+            {
+                if(!seekKey(t)) return false;
+            }
+            else if(isC('['))
+            {
+                if(!seekIdx(t)) return false;
+            }
+            else
+                return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Reads the array starting at the next token, calling `mF()`
+    /// to read every element.
+    template <typename TF>
+    inline void readArr(TF&& mF)
+    {
+        skipWS();
+        if(!isC('['))
+            throwError("Invalid array",
+                std::string{"Expected `[` , got `"} + getC() + "`");
 
         // Skip '['
         ++idx;
+        skipWS();
 
         // Empty array
         if(isC(']')) goto end;
 
-        // Reserve some memory
-        arr.reserve(10);
-
         while(true)
         {
-            // Get value
-            arr.emplace_back(parseVal());
+            mF();
+            skipWS();
 
             // Check for another value
             if(isC(','))
@@ -283,30 +958,35 @@ private:
 
         // Skip ']'
         ++idx;
-
-        return Val{arr};
     }
 
-    inline Val parseObj()
+    /// @brief Reads the object starting at the next token, calling
+    /// `mF(key)` to read every value.
+    /// @details `key` is only valid until the value is read.
+    template <typename TF>
+    inline void readObj(TF&& mF)
     {
-        Obj obj;
+        skipWS();
+        if(!isC('{'))
+            throwError("Invalid object",
+                std::string{"Expected `{` , got `"} + getC() + "`");
 
         // Skip '{'
         ++idx;
+        skipWS();
 
         // Empty object
         if(isC('}')) goto end;
 
-        // Reserve some memory
-        obj.reserve(10);
-
         while(true)
         {
             // Read string key
+            skipWS();
             if(!isC('"'))
                 throwError("Invalid object",
                     std::string{"Expected `\"` , got `"} + getC() + "`");
-            auto key(readStr());
+            const auto key(readStr());
+            skipWS();
 
             // Read ':'
             if(!isC(':'))
@@ -316,8 +996,8 @@ private:
             // Skip ':'
             ++idx;
 
-            // Read value
-            obj[std::move(key)] = parseVal();
+            mF(key);
+            skipWS();
 
             // Check for another key-value pair
             if(isC(','))
@@ -338,37 +1018,22 @@ private:
 
         // Skip '}'
         ++idx;
-
-        return Val{obj};
     }
 
-public:
-    template <typename T>
-    inline Reader(T&& mSrc) : src{FWD(mSrc)}
+    /// @brief Skips the value starting at the next token by bracket
+    /// matching, without validating it.
+    inline void skip()
     {
-        purgeSource();
+        skipVal();
     }
 
-    inline Val parseVal()
+    /// @brief Reads a single value, building a `TV` tree.
+    template <typename TV = Val>
+    inline TV parseVal()
     {
-        // Check value type
-        switch(getC())
-        {
-            case '{': return parseObj();
-            case '[': return parseArr();
-            case '"': return parseStr();
-            case 't': return parseBlnTrue();
-            case 'f': return parseBlnFalse();
-            case 'n': return parseNll();
-        }
-
-        // Check if value is a number
-        if(isNumStart(getC())) return parseNum();
-
-        throwError("Invalid value",
-            std::string{"No match for values beginning with `"} + getC() + "`");
-
-        return Val{Nll{}};
+        ValBuilder<TV> builder{bool(TRS::numArrs)};
+        parse(builder);
+        return std::move(builder.getResult());
     }
 };
 } // namespace Impl
@@ -0,0 +1,69 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_SAXHANDLER
+#define SSVU_JSON_IO_SAXHANDLER
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Num/Num.hpp"
+
+#include <string_view>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+SSVU_DEFINE_MEMFN_DETECTOR(hasOnKeyRaw, onKeyRaw)
+SSVU_DEFINE_MEMFN_DETECTOR(hasOnStrRaw, onStrRaw)
+} // namespace Impl
+
+/// @brief Base class for event-driven (SAX) JSON reading handlers.
+/// @details Every event is ignored by default. Derive from this class and
+/// hide the events of interest - they are statically dispatched, so no
+/// virtual function is involved. String views passed to `onKey` and `onStr`
+/// are only valid during the call.
+///
+/// Handlers may also define `void onKeyRaw(std::string_view, bool)` and
+/// `void onStrRaw(std::string_view, bool)`, which `Reader` then calls
+/// instead of `onKey` and `onStr`. They receive strings as they appear in
+/// the source, escape sequences included, and whether any escape sequence
+/// is present. With in-situ reading settings the views point into the
+/// source itself and remain valid as long as it does.
+struct SaxHandler
+{
+    inline void onObjBegin()
+    {
+    }
+    inline void onObjEnd()
+    {
+    }
+    inline void onArrBegin()
+    {
+    }
+    inline void onArrEnd()
+    {
+    }
+    inline void onKey(std::string_view)
+    {
+    }
+    inline void onStr(std::string_view)
+    {
+    }
+    inline void onNum(const Impl::Num&)
+    {
+    }
+    inline void onBln(Bln)
+    {
+    }
+    inline void onNll()
+    {
+    }
+};
+} // namespace Json
+} // namespace ssvu
+
+#endif
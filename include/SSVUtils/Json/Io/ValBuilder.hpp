@@ -0,0 +1,120 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_VALBUILDER
+#define SSVU_JSON_IO_VALBUILDER
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/SaxHandler.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Stores the items between `mBegin` and `mEnd` in `mOut` as a
+/// numeric array, if there are at least `Val::numArrThreshold` of them and
+/// they are all numbers read as the same type.
+/// @details Used by readers that build arrays from values, so that a source
+/// is always read into the same tree as with `ValBuilder`.
+template <typename TItr, typename TV>
+inline bool tryPackNumArr(TItr mBegin, TItr mEnd, TV& mOut);
+
+/// @brief SAX handler that builds a `TV` tree from reading events.
+/// @details Items are collected on a scratch stack until their container
+/// ends, then moved into a container created with their exact count. No
+/// container is ever reallocated or copied. If numeric arrays are enabled,
+/// arrays that only contain numbers collect them on a separate stack, from
+/// which numeric arrays are built directly.
+template <typename TV>
+class ValBuilder : public SaxHandler
+{
+private:
+    /// @brief Position of the first item of an unfinished container in
+    /// `vals` and `keys`.
+    /// @details `packing` is set for arrays whose items are all in `nums`.
+    struct Frame
+    {
+        std::size_t valBegin, keyBegin;
+        bool packing;
+    };
+
+    TV result;
+
+    /// @brief True if homogeneous arrays of numbers are stored as numeric
+    /// arrays.
+    bool packNumArrs;
+
+    /// @brief Containers currently being read, innermost last.
+    std::vector<Frame> stack;
+
+    /// @brief Items and keys of the unfinished containers.
+    std::vector<TV> vals;
+    std::vector<Key> keys;
+
+    /// @brief Items of the innermost unfinished container, if it is an
+    /// array of numbers all read as `IntS` or all read as `Real`.
+    std::vector<Num> nums;
+
+    /// @brief Positions of the items of the object being finished, sorted
+    /// by key.
+    std::vector<std::size_t> order;
+
+    /// @brief Stores the read value `mX` in the innermost unfinished
+    /// container, or as the result.
+    template <typename T>
+    inline void push(T&& mX);
+
+    /// @brief Returns the items in `nums` as `T` numbers.
+    template <typename T>
+    inline auto makeNumArr() const;
+
+    /// @brief Moves the items in `nums` to `vals`, as the innermost
+    /// unfinished array cannot be stored as a numeric array.
+    inline void stopPacking();
+
+    inline void beginContainer(bool mPacking);
+
+    /// @brief Removes the innermost unfinished container, returning the
+    /// position of its items.
+    inline Frame endContainer() noexcept;
+
+public:
+    inline ValBuilder(bool mPackNumArrs = false)
+        : packNumArrs{mPackNumArrs}
+    {
+        stack.reserve(16);
+        vals.reserve(64);
+        keys.reserve(16);
+        nums.reserve(64);
+        order.reserve(16);
+    }
+
+    inline void onObjBegin();
+    inline void onObjEnd();
+    inline void onArrBegin();
+    inline void onArrEnd();
+    inline void onKey(std::string_view mKey);
+    inline void onStr(std::string_view mStr);
+    inline void onNum(const Num& mNum);
+    inline void onBln(Bln mBln);
+    inline void onNll();
+
+    /// @brief Returns the built value.
+    inline auto& getResult() noexcept
+    {
+        return result;
+    }
+};
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -0,0 +1,228 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_IO_VALBUILDER_INL
+#define SSVU_JSON_IO_VALBUILDER_INL
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/ValBuilder.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Stores the items between `mBegin` and `mEnd` in `mOut` as a
+/// numeric array of `T`, if they are all numbers read as `T`.
+template <typename T, typename TItr, typename TV>
+inline bool tryPackNumArrAs(TItr mBegin, TItr mEnd, TV& mOut)
+{
+    constexpr auto repr(std::is_same_v<T, IntS> ? Num::Repr::IntS
+                                                : Num::Repr::Real);
+
+    if(!std::all_of(mBegin, mEnd, [](const TV& mV) {
+           return mV.getType() == ValType::TNum &&
+                  mV.template as<Num>().getRepr() == repr;
+       }))
+        return false;
+
+    std::vector<T> items;
+    items.reserve(std::distance(mBegin, mEnd));
+    for(auto i(mBegin); i != mEnd; ++i)
+        items.emplace_back(i->template as<Num>().template as<T>());
+
+    mOut.setNumArr(std::move(items));
+    return true;
+}
+
+template <typename TItr, typename TV>
+inline bool tryPackNumArr(TItr mBegin, TItr mEnd, TV& mOut)
+{
+    if(std::distance(mBegin, mEnd) < std::ptrdiff_t(TV::numArrThreshold))
+        return false;
+
+    return tryPackNumArrAs<Real>(mBegin, mEnd, mOut) ||
+           tryPackNumArrAs<IntS>(mBegin, mEnd, mOut);
+}
+
+template <typename TV>
+template <typename T>
+inline auto ValBuilder<TV>::makeNumArr() const
+{
+    std::vector<T> result;
+    result.reserve(nums.size());
+    for(const auto& n : nums) result.emplace_back(n.template as<T>());
+    return result;
+}
+
+template <typename TV>
+template <typename T>
+inline void ValBuilder<TV>::push(T&& mX)
+{
+    if(stack.empty())
+    {
+        result = FWD(mX);
+        return;
+    }
+
+    if(stack.back().packing) stopPacking();
+    vals.emplace_back(FWD(mX));
+}
+
+template <typename TV>
+inline void ValBuilder<TV>::stopPacking()
+{
+    vals.insert(std::end(vals), std::begin(nums), std::end(nums));
+    nums.clear();
+    stack.back().packing = false;
+}
+
+template <typename TV>
+inline void ValBuilder<TV>::beginContainer(bool mPacking)
+{
+    if(!stack.empty() && stack.back().packing) stopPacking();
+    stack.push_back({vals.size(), keys.size(), mPacking});
+}
+
+template <typename TV>
+inline auto ValBuilder<TV>::endContainer() noexcept -> Frame
+{
+    const auto f(stack.back());
+    stack.pop_back();
+    return f;
+}
+
+template <typename TV>
+inline void ValBuilder<TV>::onObjBegin()
+{
+    beginContainer(false);
+}
+template <typename TV>
+inline void ValBuilder<TV>::onObjEnd()
+{
+    const auto f(endContainer());
+    const auto valItr(std::begin(vals) + f.valBegin);
+    const auto keyItr(std::begin(keys) + f.keyBegin);
+    const auto count(vals.size() - f.valBegin);
+
+    typename TV::Obj obj;
+    obj.reserve(count);
+
+    if constexpr(std::is_same_v<decltype(obj), VecMap<Key, TV>>)
+    {
+        // Sorting the items once is faster than inserting them one by one
+        // in sorted position. Of equal keys, the last one is kept.
+        order.resize(count);
+        std::iota(std::begin(order), std::end(order), std::size_t(0));
+
+        if(!std::is_sorted(keyItr, std::end(keys)))
+            std::stable_sort(std::begin(order), std::end(order),
+                [&](auto mA, auto mB) { return keyItr[mA] < keyItr[mB]; });
+
+        auto& data(obj.getData());
+        for(auto i : order)
+            if(!data.empty() && data.back().first == keyItr[i])
+                data.back().second = std::move(valItr[i]);
+            else
+                data.emplace_back(std::move(keyItr[i]), std::move(valItr[i]));
+    }
+    else
+    {
+        // Hashed objects keep the position of the first of equal keys
+        for(std::size_t i{0}; i < count; ++i)
+            obj[std::move(keyItr[i])] = std::move(valItr[i]);
+    }
+
+    vals.erase(valItr, std::end(vals));
+    keys.erase(keyItr, std::end(keys));
+    push(std::move(obj));
+}
+template <typename TV>
+inline void ValBuilder<TV>::onArrBegin()
+{
+    beginContainer(packNumArrs);
+}
+template <typename TV>
+inline void ValBuilder<TV>::onArrEnd()
+{
+    const auto f(endContainer());
+
+    if(f.packing)
+    {
+        // Homogeneous arrays of numbers are stored contiguously
+        if(nums.size() >= TV::numArrThreshold)
+        {
+            TV packed;
+            if(nums.front().getRepr() == Num::Repr::IntS)
+                packed.setNumArr(makeNumArr<IntS>());
+            else
+                packed.setNumArr(makeNumArr<Real>());
+
+            nums.clear();
+            push(std::move(packed));
+            return;
+        }
+
+        typename TV::Arr arr(std::begin(nums), std::end(nums));
+        nums.clear();
+        push(std::move(arr));
+        return;
+    }
+
+    const auto itr(std::begin(vals) + f.valBegin);
+    typename TV::Arr arr(std::make_move_iterator(itr),
+        std::make_move_iterator(std::end(vals)));
+
+    vals.erase(itr, std::end(vals));
+    push(std::move(arr));
+}
+template <typename TV>
+inline void ValBuilder<TV>::onKey(std::string_view mKey)
+{
+    keys.emplace_back(mKey.data(), mKey.size());
+}
+template <typename TV>
+inline void ValBuilder<TV>::onStr(std::string_view mStr)
+{
+    push(Str{mStr});
+}
+template <typename TV>
+inline void ValBuilder<TV>::onNum(const Num& mNum)
+{
+    if(!stack.empty() && stack.back().packing)
+    {
+        const auto repr(mNum.getRepr());
+        if((repr == Num::Repr::IntS || repr == Num::Repr::Real) &&
+            (nums.empty() || nums.front().getRepr() == repr))
+        {
+            nums.emplace_back(mNum);
+            return;
+        }
+    }
+
+    push(mNum);
+}
+template <typename TV>
+inline void ValBuilder<TV>::onBln(Bln mBln)
+{
+    push(mBln);
+}
+template <typename TV>
+inline void ValBuilder<TV>::onNll()
+{
+    push(Nll{});
+}
+} // namespace Impl
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -8,8 +8,18 @@
 #include "SSVUtils/Core/Core.hpp"
 #include "SSVUtils/Json/Common/Common.hpp"
 #include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/Internal/WriterSinks.hpp"
+#include "SSVUtils/Json/Io/Internal/StrEscaper.hpp"
 
+#include <array>
+#include <charconv>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <cmath>
 
 namespace ssvu
 {
@@ -17,60 +27,130 @@ namespace Json
 {
 namespace Impl
 {
-template <typename TWS = WSPretty>
+/// @brief Number of spaces per indentation level.
+constexpr std::size_t indentWidth{4};
+
+/// @brief Number of indentation levels written with a single append.
+constexpr std::size_t indentTableLevels{32};
+
+inline constexpr auto makeIndentTable() noexcept
+{
+    std::array<char, indentWidth * indentTableLevels> result{};
+    for(std::size_t i{0}; i < result.size(); ++i) result[i] = ' ';
+    return result;
+}
+
+/// @brief Spaces for up to `indentTableLevels` indentation levels.
+inline constexpr auto indentTable(makeIndentTable());
+
+/// @brief Writes `Val`s to a sink, which must provide `put(std::string_view)`
+/// and `put(char)`.
+/// @details Output is written to the sink as it is produced: buffered
+/// sinks never hold more than their buffer size.
+template <typename TWS = WSPretty, typename TSink = StrSink>
 class Writer
 {
 private:
     using FmtCC = Console::Color;
     using FmtCS = Console::Style;
 
-    std::string out;
+    TSink& sink;
     std::size_t depth{0};
     bool needIndent{false};
 
-    inline auto isObjOrArr(const Val& mVal)
+    /// @brief Console format strings built so far, and the index of the
+    /// last one written. Only used if `TWS::fmt` is true.
+    struct FmtEntry
+    {
+        FmtCC color;
+        FmtCS style;
+        std::string str;
+    };
+    std::vector<FmtEntry> fmtCache;
+    std::size_t lastFmt{0};
+
+    template <bool THashedObj, bool TCow>
+    inline auto isObjOrArr(const ValImpl<THashedObj, TCow>& mVal)
     {
-        return mVal.getType() == Val::Type::TObj ||
-               mVal.getType() == Val::Type::TArr;
+        return mVal.getType() == ValType::TObj ||
+               mVal.getType() == ValType::TArr;
     }
 
     inline void indent()
     {
-        for(auto i(0u); i < depth; ++i) out += "    ";
+        const std::string_view table{indentTable.data(), indentTable.size()};
+
+        auto levels(depth);
+        for(; levels > indentTableLevels; levels -= indentTableLevels)
+            sink.put(table);
+
+        sink.put(table.substr(0, levels * indentWidth));
         needIndent = false;
     }
 
-    inline void wFmt(FmtCC mColor, FmtCS mStyle = FmtCS::None)
+    inline void wFmt(
+        [[maybe_unused]] FmtCC mColor, [[maybe_unused]] FmtCS mStyle = {})
     {
-        if(!TWS::fmt) return;
-        appendTo(out, Console::resetFmt(), Console::setColorFG(mColor),
-            Console::setStyle(mStyle));
+        if constexpr(TWS::fmt)
+        {
+            // Format strings are expensive to build: they are cached, and
+            // redundant ones are skipped
+            auto i(0u);
+            while(i < fmtCache.size() && (fmtCache[i].color != mColor ||
+                                             fmtCache[i].style != mStyle))
+                ++i;
+
+            if(i == fmtCache.size())
+            {
+                // The last format string reflects all the previous calls
+                Console::resetFmt();
+                Console::setColorFG(mColor);
+                const std::string& fmt(Console::setStyle(mStyle));
+                fmtCache.push_back({mColor, mStyle, fmt});
+            }
+            else if(i + 1 == lastFmt)
+                return;
+
+            lastFmt = i + 1;
+            sink.put(fmtCache[i].str);
+        }
     }
 
     inline void wNL()
     {
-        if(TWS::pretty)
+        if constexpr(TWS::pretty)
         {
-            out += "\n";
+            sink.put('\n');
             needIndent = true;
         }
     }
     inline void wWS()
     {
-        if(TWS::pretty)
-        {
-            out += " ";
-        }
+        if constexpr(TWS::pretty) sink.put(' ');
     }
 
-    inline void wOut(const std::string& mStr)
+    template <typename T>
+    inline void wOut(const T& mX)
     {
-        if(TWS::pretty)
-        {
+        if constexpr(TWS::pretty)
             if(needIndent) indent();
-        }
 
-        out += mStr;
+        sink.put(mX);
+    }
+
+    inline void wQuoted(std::string_view mStr)
+    {
+        wOut('"');
+        writeEscaped(sink, mStr);
+        sink.put('"');
+    }
+
+    template <typename T>
+    inline void wInt(T mX)
+    {
+        char buf[std::numeric_limits<T>::digits10 + 3];
+        const auto r(std::to_chars(std::begin(buf), std::end(buf), mX));
+        wOut(std::string_view(buf, r.ptr - buf));
     }
 
     template <typename TItr, typename TF1, typename TF2>
@@ -85,12 +165,12 @@ private:
         mF1(mBegin);
     }
 
-
-
-    inline void write(const Obj& mObj)
+    /// @brief Writes an `Obj`, in its own key order.
+    template <typename TObj>
+    inline void writeObj(const TObj& mObj)
     {
         wFmt(FmtCC::LightGray, FmtCS::Bold);
-        wOut("{");
+        wOut('{');
         wNL();
 
         ++depth;
@@ -101,15 +181,16 @@ private:
                 writeKey(mItr->first);
 
                 wFmt(FmtCC::LightGray, FmtCS::Bold);
-                wOut(":");
+                wOut(':');
                 wWS();
 
-                if(isObjOrArr(mItr->second)) wNL();
+                if constexpr(TWS::pretty)
+                    if(isObjOrArr(mItr->second)) wNL();
 
                 write(mItr->second);
             },
             [this] {
-                wOut(",");
+                wOut(',');
                 wWS();
                 wNL();
             });
@@ -118,23 +199,30 @@ private:
 
         wFmt(FmtCC::LightGray, FmtCS::Bold);
         wNL();
-        wOut("}");
+        wOut('}');
     }
 
-    inline void write(const Arr& mArr)
+    /// @brief Writes an `Arr`, or the items of a numeric array.
+    template <typename TC>
+    inline void writeArr(const TC& mArr)
     {
         wFmt(FmtCC::LightGray, FmtCS::Bold);
-        wOut("[");
+        wOut('[');
         wNL();
 
         ++depth;
 
         repeatWithSeparator(
             std::begin(mArr), std::end(mArr),
-            [this](auto mItr) { this->write(*mItr); },
+            [this](auto mItr) {
+                if constexpr(std::is_arithmetic_v<typename TC::value_type>)
+                    this->write(Num{*mItr});
+                else
+                    this->write(*mItr);
+            },
             [this] {
                 wFmt(FmtCC::LightGray, FmtCS::Bold);
-                wOut(",");
+                wOut(',');
                 wWS();
                 wNL();
             });
@@ -143,19 +231,34 @@ private:
 
         wFmt(FmtCC::LightGray, FmtCS::Bold);
         wNL();
-        wOut("]");
+        wOut(']');
     }
 
     inline void writeKey(const Key& mKey)
     {
         wFmt(FmtCC::LightGray);
-        wOut("\"" + mKey + "\"");
+        wQuoted(mKey);
     }
 
     inline void write(const Str& mStr)
     {
         wFmt(FmtCC::LightYellow);
-        wOut("\"" + mStr + "\"");
+        wQuoted(mStr);
+    }
+
+    inline void writeReal(Real mX)
+    {
+        // Non-finite numbers cannot be represented in JSON
+        if(SSVU_UNLIKELY(!std::isfinite(mX)))
+        {
+            wOut("null");
+            return;
+        }
+
+        // Integral values keep a trailing `.0` to be read back as `Real`
+        char buf[ssvu::Impl::FastRealToStr::bufferSize];
+        const auto end(ssvu::Impl::FastRealToStr::toChars(buf, mX, true));
+        wOut(std::string_view(buf, end - buf));
     }
 
     inline void write(const Num& mNum)
@@ -164,9 +267,9 @@ private:
 
         switch(mNum.getRepr())
         {
-            case Num::Repr::IntS: wOut(toStr(mNum.as<IntS>())); break;
-            case Num::Repr::IntU: wOut(toStr(mNum.as<IntU>())); break;
-            case Num::Repr::Real: wOut(toStr(mNum.as<Real>())); break;
+            case Num::Repr::IntS: wInt(mNum.as<IntS>()); break;
+            case Num::Repr::IntU: wInt(mNum.as<IntU>()); break;
+            case Num::Repr::Real: writeReal(mNum.as<Real>()); break;
         }
     }
 
@@ -182,15 +285,24 @@ private:
         wOut("null");
     }
 
-    void write(const Val& mVal);
-
 public:
-    inline void write(const Val& mVal, std::ostream& mStream)
+    inline Writer(TSink& mSink) noexcept : sink{mSink}
     {
-        write(mVal);
-        mStream << out;
     }
+
+    /// @brief Writes `mVal` to the sink, without flushing it.
+    template <bool THashedObj, bool TCow>
+    void write(const ValImpl<THashedObj, TCow>& mVal);
 };
+
+/// @brief Writes `mVal` to `mSink` and flushes it, returning false if
+/// the sink failed.
+template <typename TWS, typename TSink, bool THashedObj, bool TCow>
+inline bool writeToSink(const ValImpl<THashedObj, TCow>& mVal, TSink& mSink)
+{
+    Writer<TWS, TSink>{mSink}.write(mVal);
+    return mSink.flush();
+}
 } // namespace Impl
 } // namespace Json
 } // namespace ssvu
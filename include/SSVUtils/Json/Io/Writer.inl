@@ -16,17 +16,27 @@ namespace Json
 {
 namespace Impl
 {
-template <typename TWS>
-inline void Writer<TWS>::write(const Val& mVal)
+template <typename TWS, typename TSink>
+template <bool THashedObj, bool TCow>
+inline void Writer<TWS, TSink>::write(const ValImpl<THashedObj, TCow>& mVal)
 {
+    using V = ValImpl<THashedObj, TCow>;
+
     switch(mVal.getType())
     {
-        case Val::Type::TObj: write(mVal.as<Obj>()); break;
-        case Val::Type::TArr: write(mVal.as<Arr>()); break;
-        case Val::Type::TStr: write(mVal.as<Str>()); break;
-        case Val::Type::TNum: write(mVal.as<Num>()); break;
-        case Val::Type::TBln: write(mVal.as<Bln>()); break;
-        case Val::Type::TNll: write(Nll{}); break;
+        case ValType::TObj:
+            writeObj(mVal.template as<typename V::Obj>());
+            break;
+        case ValType::TArr:
+            if(!mVal.visitNumArr([this](const auto& mItems) {
+                   writeArr(mItems);
+               }))
+                writeArr(mVal.template as<typename V::Arr>());
+            break;
+        case ValType::TStr: write(mVal.template as<Str>()); break;
+        case ValType::TNum: write(mVal.template as<Num>()); break;
+        case ValType::TBln: write(mVal.template as<Bln>()); break;
+        case ValType::TNll: write(Nll{}); break;
         default: SSVU_UNREACHABLE();
     }
 }
@@ -18,6 +18,16 @@
 #include "SSVUtils/Json/Io/Writer.inl"
 #include "SSVUtils/Json/Val/Internal/CnvFuncs.hpp"
 #include "SSVUtils/Json/Val/Internal/CnvMacros.hpp"
+#include "SSVUtils/Json/Io/ValBuilder.inl"
+#include "SSVUtils/Json/Io/NdJson.hpp"
+#include "SSVUtils/Json/Io/ParallelArr.hpp"
+#include "SSVUtils/Json/Io/Pointer.hpp"
+#include "SSVUtils/Json/Val/Patch.hpp"
+#include "SSVUtils/Json/Val/Hash.hpp"
+#include "SSVUtils/Json/Io/CnvStream.hpp"
+#include "SSVUtils/Json/Io/Bin.hpp"
+#include "SSVUtils/Json/Doc/Document.hpp"
+#include "SSVUtils/Json/Doc/Document.inl"
 #include "SSVUtils/Json/Stringifier/Stringifier.hpp"
 
 #endif
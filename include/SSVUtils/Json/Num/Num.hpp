@@ -8,6 +8,9 @@
 #include "SSVUtils/Union/Union.hpp"
 #include "SSVUtils/Json/Common/Common.hpp"
 
+#include <cstdint>
+#include <type_traits>
+
 namespace ssvu
 {
 namespace Json
@@ -32,7 +35,7 @@ class Num
 
 public:
     /// @brief Representation/storage type of numeric values.
-    enum class Repr
+    enum class Repr : std::uint8_t
     {
         IntS,
         IntU,
@@ -40,8 +43,10 @@ public:
     };
 
 private:
-    /// @brief Current representation in use.
-    Repr repr;
+    /// @brief Current representation in use, as a `Repr`.
+    /// @details Must stay the first member: `Val` reads it as its own type
+    /// tag.
+    std::uint8_t repr;
 
     /// @brief Union POD storage for representation types.
     UnionPOD<IntS, IntU, Real> h;
@@ -49,17 +54,17 @@ private:
     // Union setters
     inline void setIntS(const IntU& mX) noexcept
     {
-        repr = Repr::IntS;
+        repr = std::uint8_t(Repr::IntS);
         h.init<IntS>(mX);
     }
     inline void setIntU(const IntS& mX) noexcept
     {
-        repr = Repr::IntU;
+        repr = std::uint8_t(Repr::IntU);
         h.init<IntU>(mX);
     }
     inline void setReal(const Real& mX) noexcept
     {
-        repr = Repr::Real;
+        repr = std::uint8_t(Repr::Real);
         h.init<Real>(mX);
     }
 
@@ -67,7 +72,7 @@ private:
     /// copied and casted if necessary.
     inline IntS getIntS() const noexcept
     {
-        switch(repr)
+        switch(Repr(repr))
         {
             case Repr::IntS: return h.get<IntS>();
             case Repr::IntU: return toNum<IntS>(h.get<IntU>());
@@ -80,7 +85,7 @@ private:
     /// copied and casted if necessary.
     inline IntU getIntU() const noexcept
     {
-        switch(repr)
+        switch(Repr(repr))
         {
             case Repr::IntS: return toNum<IntU>(h.get<IntS>());
             case Repr::IntU: return h.get<IntU>();
@@ -93,7 +98,7 @@ private:
     /// copied and casted if necessary.
     inline Real getReal() const noexcept
     {
-        switch(repr)
+        switch(Repr(repr))
         {
             case Repr::IntS: return toNum<Real>(h.get<IntS>());
             case Repr::IntU: return toNum<Real>(h.get<IntU>());
@@ -133,13 +138,13 @@ public:
     /// @brief Returns the current representation type.
     inline auto getRepr() const noexcept
     {
-        return repr;
+        return Repr(repr);
     }
 
     // Equality/inequality
     inline bool operator==(const Num& mN) const noexcept
     {
-        switch(repr)
+        switch(Repr(repr))
         {
             case Repr::IntS: return getIntS() == mN.getIntS();
             case Repr::IntU: return getIntU() == mN.getIntU();
@@ -152,6 +157,9 @@ public:
         return !(operator==(mN));
     }
 };
+
+static_assert(std::is_standard_layout_v<Num> && std::is_trivial_v<Num>,
+    "`Num` must be trivial, as it is stored in a union by `Val`");
 } // namespace Impl
 } // namespace Json
 } // namespace ssvu
@@ -9,13 +9,15 @@
 
 namespace ssvu
 {
-template <>
-struct Stringifier<Json::Val>
+template <bool THashedObj, bool TCow>
+struct Stringifier<Json::Impl::ValImpl<THashedObj, TCow>>
 {
     template <bool TFmt>
-    inline static void impl(std::ostream& mStream, const Json::Val& mVal)
+    inline static void impl(std::ostream& mStream,
+        const Json::Impl::ValImpl<THashedObj, TCow>& mVal)
     {
-        mVal.writeToStream<Json::WriterSettings<TFmt, true>>(mStream);
+        mVal.template writeToStream<Json::WriterSettings<TFmt, true>>(
+            mStream);
     }
 };
 } // namespace ssvu
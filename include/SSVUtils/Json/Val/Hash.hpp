@@ -0,0 +1,311 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_VAL_HASH
+#define SSVU_JSON_VAL_HASH
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Scrambles the bits of `mX` (splitmix64 finalizer).
+inline std::size_t mixHash(std::uint64_t mX) noexcept
+{
+    mX ^= mX >> 30;
+    mX *= 0xbf58476d1ce4e5b9ull;
+    mX ^= mX >> 27;
+    mX *= 0x94d049bb133111ebull;
+    mX ^= mX >> 31;
+    return std::size_t(mX);
+}
+
+inline std::size_t combineHash(std::size_t mSeed, std::size_t mX) noexcept
+{
+    return mixHash(mSeed ^ (mX + 0x9e3779b97f4a7c15ull + (mSeed << 6)));
+}
+
+inline std::size_t hashStr(std::string_view mStr) noexcept
+{
+    return std::hash<std::string_view>{}(mStr);
+}
+
+/// @brief Representation-independent form of a number.
+/// @details Two numbers have the same value if and only if their forms are
+/// equal. Integral reals are stored as integers, so that `1`, `1u` and
+/// `1.0` have the same form.
+struct NumForm
+{
+    enum Kind : std::uint8_t
+    {
+        NonNegative,
+        Negative,
+        NonIntegral
+    };
+
+    Kind kind;
+    std::uint64_t bits;
+
+    inline bool operator==(const NumForm& mX) const noexcept
+    {
+        return kind == mX.kind && bits == mX.bits;
+    }
+};
+
+inline NumForm getNumForm(const Num& mNum) noexcept
+{
+    constexpr Real minIntS{-9223372036854775808.0};
+    constexpr Real maxIntU{18446744073709551616.0};
+
+    const auto repr(mNum.getRepr());
+    if(repr == Num::Repr::IntU) return {NumForm::NonNegative, mNum.as<IntU>()};
+
+    if(repr == Num::Repr::IntS)
+    {
+        const auto i(mNum.as<IntS>());
+        return {i < 0 ? NumForm::Negative : NumForm::NonNegative, IntU(i)};
+    }
+
+    const auto r(mNum.as<Real>());
+    if(std::trunc(r) == r && r >= minIntS && r < maxIntU)
+        return r < 0 ? NumForm{NumForm::Negative, IntU(IntS(r))}
+                     : NumForm{NumForm::NonNegative, IntU(r)};
+
+    std::uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(r));
+    std::memcpy(&bits, &r, sizeof(bits));
+    return {NumForm::NonIntegral, bits};
+}
+
+/// @brief Hashes `mNum` by its value, regardless of its representation.
+inline std::size_t hashNum(const Num& mNum) noexcept
+{
+    return mixHash(getNumForm(mNum).bits);
+}
+
+/// @brief Stores the `mIdx`-th item of the array `mV` in `mOut`, returning
+/// false if it is not a number.
+/// @details Numeric arrays are read without being unpacked.
+template <typename TV>
+inline bool getArrNum(const TV& mV, Idx mIdx, Num& mOut) noexcept
+{
+    if(mV.visitNumArr([&](const auto& mItems) { mOut = Num{mItems[mIdx]}; }))
+        return true;
+
+    const auto& v(mV.template as<typename TV::Arr>()[mIdx]);
+    if(!v.template is<Num>()) return false;
+
+    mOut = v.template as<Num>();
+    return true;
+}
+} // namespace Impl
+
+/// @brief Returns a structural hash of `mV`.
+/// @details Values equal according to `isStructEqual` have equal hashes.
+/// Numbers are hashed by value and object members regardless of their
+/// order. Visits the whole value: use `Hashed` to compute the hash of a
+/// value once.
+template <bool THashedObj, bool TCow>
+inline std::size_t hash(const Impl::ValImpl<THashedObj, TCow>& mV) noexcept
+{
+    using namespace Impl;
+    using V = ValImpl<THashedObj, TCow>;
+
+    switch(mV.getType())
+    {
+        case ValType::TObj:
+        {
+            const auto& obj(mV.template as<typename V::Obj>());
+
+            // Members are summed, so that their order does not matter
+            auto result(mixHash(obj.size() + 1));
+            for(const auto& p : obj)
+                result += combineHash(hashStr(p.first), hash(p.second));
+
+            return result;
+        }
+        case ValType::TArr:
+        {
+            auto result(mixHash(mV.getSizeArr() + 2));
+
+            // Items of numeric arrays are hashed like `Num` values
+            if(!mV.visitNumArr([&](const auto& mItems) {
+                   for(auto x : mItems)
+                       result = combineHash(
+                           result, combineHash(4, hashNum(Num{x})));
+               }))
+                for(const auto& v : mV.template as<typename V::Arr>())
+                    result = combineHash(result, hash(v));
+
+            return result;
+        }
+        case ValType::TStr:
+            return combineHash(3, hashStr(mV.template as<Str>()));
+        case ValType::TNum:
+            return combineHash(4, hashNum(mV.template as<Num>()));
+        case ValType::TBln: return combineHash(5, mV.template as<Bln>());
+        case ValType::TNll: return mixHash(6);
+        default: SSVU_UNREACHABLE();
+    }
+}
+
+/// @brief Returns true if `mA` and `mB` are structurally equal: the
+/// equality that `hash` is consistent with.
+/// @details Numbers are compared by value, whatever their representation,
+/// and object members regardless of their order. Unlike `operator==`,
+/// which converts the right number to the representation of the left
+/// one, it is symmetric: `Val{1}` and `Val{1.5}` are not equal.
+template <bool THashedObj, bool TCow>
+inline bool isStructEqual(const Impl::ValImpl<THashedObj, TCow>& mA,
+    const Impl::ValImpl<THashedObj, TCow>& mB) noexcept
+{
+    using namespace Impl;
+    using V = ValImpl<THashedObj, TCow>;
+
+    if(mA.sharesStorageWith(mB)) return true;
+
+    const auto type(mA.getType());
+    if(type != mB.getType()) return false;
+
+    switch(type)
+    {
+        case ValType::TObj:
+        {
+            const auto& a(mA.template as<typename V::Obj>());
+            const auto& b(mB.template as<typename V::Obj>());
+            if(a.size() != b.size()) return false;
+
+            for(const auto& p : a)
+            {
+                const auto itr(b.atItr(p.first));
+                if(itr == std::end(b) || !isStructEqual(p.second, itr->second))
+                    return false;
+            }
+
+            return true;
+        }
+        case ValType::TArr:
+        {
+            const auto size(mA.getSizeArr());
+            if(size != mB.getSizeArr()) return false;
+
+            // Items of numeric arrays are compared like `Num` values
+            const auto aNums(mA.template isNumArr<IntS>() ||
+                             mA.template isNumArr<Real>());
+            const auto bNums(mB.template isNumArr<IntS>() ||
+                             mB.template isNumArr<Real>());
+
+            if(!aNums && !bNums)
+            {
+                const auto& a(mA.template as<typename V::Arr>());
+                const auto& b(mB.template as<typename V::Arr>());
+                for(auto i(0u); i < size; ++i)
+                    if(!isStructEqual(a[i], b[i])) return false;
+
+                return true;
+            }
+
+            Num na, nb;
+            for(auto i(0u); i < size; ++i)
+                if(!getArrNum(mA, i, na) || !getArrNum(mB, i, nb) ||
+                    !(getNumForm(na) == getNumForm(nb)))
+                    return false;
+
+            return true;
+        }
+        case ValType::TStr:
+            return mA.template as<Str>() == mB.template as<Str>();
+        case ValType::TNum:
+            return getNumForm(mA.template as<Num>()) ==
+                   getNumForm(mB.template as<Num>());
+        case ValType::TBln:
+            return mA.template as<Bln>() == mB.template as<Bln>();
+        case ValType::TNll: return true;
+        default: SSVU_UNREACHABLE();
+    }
+}
+
+/// @brief Immutable `Val` stored with its hash, computed once.
+/// @details Can be used as key of unordered containers to deduplicate
+/// values. Values are compared with `isStructEqual`, only when their
+/// hashes are equal.
+class Hashed
+{
+private:
+    Val val;
+    std::size_t h;
+
+public:
+    inline Hashed(Val mV) : val{std::move(mV)}, h{hash(val)}
+    {
+    }
+
+    inline const auto& getVal() const noexcept
+    {
+        return val;
+    }
+    inline auto getHash() const noexcept
+    {
+        return h;
+    }
+
+    inline bool operator==(const Hashed& mX) const noexcept
+    {
+        return h == mX.h && isStructEqual(val, mX.val);
+    }
+    inline bool operator!=(const Hashed& mX) const noexcept
+    {
+        return !(operator==(mX));
+    }
+};
+} // namespace Json
+} // namespace ssvu
+
+namespace std
+{
+template <bool THashedObj, bool TCow>
+struct hash<ssvu::Json::Impl::ValImpl<THashedObj, TCow>>
+{
+    inline auto operator()(
+        const ssvu::Json::Impl::ValImpl<THashedObj, TCow>& mV) const noexcept
+    {
+        return ssvu::Json::hash(mV);
+    }
+};
+
+/// @brief Compares JSON values with `isStructEqual`, so that unordered
+/// containers use the equality their hash is consistent with.
+template <bool THashedObj, bool TCow>
+struct equal_to<ssvu::Json::Impl::ValImpl<THashedObj, TCow>>
+{
+    inline bool operator()(
+        const ssvu::Json::Impl::ValImpl<THashedObj, TCow>& mA,
+        const ssvu::Json::Impl::ValImpl<THashedObj, TCow>& mB) const noexcept
+    {
+        return ssvu::Json::isStructEqual(mA, mB);
+    }
+};
+
+template <>
+struct hash<ssvu::Json::Hashed>
+{
+    inline auto operator()(const ssvu::Json::Hashed& mX) const noexcept
+    {
+        return mX.getHash();
+    }
+};
+} // namespace std
+
+#endif
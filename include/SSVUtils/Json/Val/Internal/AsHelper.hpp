@@ -9,6 +9,7 @@
 
 #include <vrm/pp.hpp>
 
+#include <utility>
 #include <vector>
 
 namespace ssvu
@@ -26,7 +27,7 @@ struct AsHelper
     {
         T result;
         Cnv<std::remove_cv_t<std::remove_reference_t<T>>>::fromVal(
-            FWD(mV), result);
+            fwdCnvSrc(FWD(mV)), result);
         return result;
     }
 };
@@ -42,32 +43,37 @@ struct AsHelper
         }                                            \
     };
 
-#define SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(mType)         \
-    template <>                                              \
-    struct AsHelper<mType> final                             \
-    {                                                        \
-        inline static const auto& as(const Val& mV) noexcept \
-        {                                                    \
-            return VRM_PP_CAT(mV.get, mType)();              \
-        }                                                    \
-        inline static auto&& as(Val&& mV) noexcept           \
-        {                                                    \
-            return VRM_PP_CAT(mV.get, mType)();              \
-        }                                                    \
-        inline static auto& as(Val& mV) noexcept             \
-        {                                                    \
-            return VRM_PP_CAT(mV.get, mType)();              \
-        }                                                    \
+#define SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(mName, mType)              \
+    template <>                                                          \
+    struct AsHelper<mType> final                                         \
+    {                                                                    \
+        template <bool THashedObj, bool TCow>                            \
+        inline static const auto& as(                                    \
+            const ValImpl<THashedObj, TCow>& mV) noexcept                \
+        {                                                                \
+            return VRM_PP_CAT(mV.get, mName)();                          \
+        }                                                                \
+        template <bool THashedObj, bool TCow>                            \
+        inline static auto&& as(ValImpl<THashedObj, TCow>&& mV) noexcept \
+        {                                                                \
+            return VRM_PP_CAT(mV.get, mName)();                          \
+        }                                                                \
+        template <bool THashedObj, bool TCow>                            \
+        inline static auto& as(ValImpl<THashedObj, TCow>& mV) noexcept   \
+        {                                                                \
+            return VRM_PP_CAT(mV.get, mName)();                          \
+        }                                                                \
     };
 
-#define SSVU_JSON_DEFINE_ASHELPER_SMALL_IMMUTABLE(mType) \
-    template <>                                          \
-    struct AsHelper<mType> final                         \
-    {                                                    \
-        inline static auto as(const Val& mV) noexcept    \
-        {                                                \
-            return VRM_PP_CAT(mV.get, mType)();          \
-        }                                                \
+#define SSVU_JSON_DEFINE_ASHELPER_SMALL_IMMUTABLE(mType)                    \
+    template <>                                                             \
+    struct AsHelper<mType> final                                            \
+    {                                                                       \
+        template <bool THashedObj, bool TCow>                               \
+        inline static auto as(const ValImpl<THashedObj, TCow>& mV) noexcept \
+        {                                                                   \
+            return VRM_PP_CAT(mV.get, mType)();                             \
+        }                                                                   \
     };
 
 SSVU_JSON_DEFINE_ASHELPER_NUM(char)
@@ -79,10 +85,14 @@ SSVU_JSON_DEFINE_ASHELPER_NUM(unsigned long int)
 SSVU_JSON_DEFINE_ASHELPER_NUM(float)
 SSVU_JSON_DEFINE_ASHELPER_NUM(double)
 
-SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Obj)
-SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Arr)
-SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Str)
-SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Num)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Obj, Val::Obj)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Obj, HashedVal::Obj)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Obj, CowVal::Obj)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Arr, Val::Arr)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Arr, HashedVal::Arr)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Arr, CowVal::Arr)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Str, Str)
+SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE(Num, Num)
 
 SSVU_JSON_DEFINE_ASHELPER_SMALL_IMMUTABLE(Bln)
 SSVU_JSON_DEFINE_ASHELPER_SMALL_IMMUTABLE(Nll)
@@ -91,18 +101,18 @@ SSVU_JSON_DEFINE_ASHELPER_SMALL_IMMUTABLE(Nll)
 #undef SSVU_JSON_DEFINE_ASHELPER_BIG_MUTABLE
 #undef SSVU_JSON_DEFINE_ASHELPER_SMALL_IMMUTABLE
 
-template <>
-struct AsHelper<Val> final
+template <bool THashedObj, bool TCow>
+struct AsHelper<ValImpl<THashedObj, TCow>> final
 {
-    inline static const auto& as(const Val& mV) noexcept
+    inline static const auto& as(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
         return mV;
     }
-    inline static auto&& as(Val&& mV) noexcept
+    inline static auto&& as(ValImpl<THashedObj, TCow>&& mV) noexcept
     {
         return std::move(mV);
     }
-    inline static auto& as(Val& mV) noexcept
+    inline static auto& as(ValImpl<THashedObj, TCow>& mV) noexcept
     {
         return mV;
     }
@@ -114,8 +124,17 @@ struct AsHelper<std::vector<TItem>> final
     template <typename T>
     inline static auto as(T&& mV)
     {
-        const auto& arr(mV.template as<Arr>());
         std::vector<TItem> result;
+
+        // Numeric arrays are converted without building an `Arr`
+        if constexpr(std::is_arithmetic_v<TItem> &&
+                     !std::is_same_v<TItem, Bln>)
+            if(mV.visitNumArr([&](const auto& mItems) {
+                   result.assign(std::begin(mItems), std::end(mItems));
+               }))
+                return result;
+
+        const auto& arr(std::as_const(mV).getArr());
         result.reserve(arr.size());
         for(auto i(0u); i < arr.size(); ++i)
             result.emplace_back(
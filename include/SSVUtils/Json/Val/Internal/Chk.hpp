@@ -26,28 +26,36 @@ struct TplIsHelper
     using TplArg = std::tuple_element_t<TI,
         std::remove_cv_t<std::remove_reference_t<TTpl>>>;
 
-    template <std::size_t TI = 0, typename... TArgs>
+    template <std::size_t TI = 0, typename... TArgs, bool THashedObj, bool TCow>
     inline static std::enable_if_t<TI == sizeof...(TArgs), bool> isTpl(
-        const Val&) noexcept
+        const ValImpl<THashedObj, TCow>&) noexcept
     {
         return true;
     }
-    template <std::size_t TI = 0, typename... TArgs>
+    template <std::size_t TI = 0, typename... TArgs, bool THashedObj, bool TCow>
         inline static std::enable_if_t <
-        TI<sizeof...(TArgs), bool> isTpl(const Val& mV) noexcept
+        TI<sizeof...(TArgs), bool> isTpl(
+            const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        assert(mV.is<Arr>() && mV.getArr().size() > TI);
-        if(!mV[TI].isNoNum<TplArg<TI, std::tuple<TArgs...>>>()) return false;
+        assert(mV.template is<Arr>() && mV.getSizeArr() > TI);
+        if(!mV[TI].template isNoNum<TplArg<TI, std::tuple<TArgs...>>>())
+            return false;
         return isTpl<TI + 1, TArgs...>(mV);
     }
 
     /// @brief Returns `true` if all items of an `Arr` are of type
     /// `T`.
-    template <typename T>
+    template <typename T, bool THashedObj, bool TCow>
     inline static bool SSVU_ATTRIBUTE(pure)
-        areArrItemsOfType(const Val& mV) noexcept
+        areArrItemsOfType(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        assert(mV.is<Arr>());
+        assert(mV.template is<Arr>());
+
+        // Numeric arrays only store numbers
+        if constexpr(std::is_arithmetic_v<T> && !std::is_same_v<T, Bln>)
+            if(mV.template isNumArr<IntS>() || mV.template isNumArr<Real>())
+                return true;
+
         for(const auto& v : mV.getArr())
             if(!v.template isNoNum<T>()) return false;
         return true;
@@ -57,7 +65,9 @@ struct TplIsHelper
 template <typename T>
 struct Chk
 {
-    inline static bool SSVU_ATTRIBUTE(const) is(const Val&) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static bool SSVU_ATTRIBUTE(const)
+        is(const ValImpl<THashedObj, TCow>&) noexcept
     {
         return true;
     }
@@ -65,7 +75,9 @@ struct Chk
 template <typename T>
 struct ChkNoNum
 {
-    inline static bool SSVU_ATTRIBUTE(pure) is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static bool SSVU_ATTRIBUTE(pure)
+        is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
         return Chk<std::remove_cv_t<std::remove_reference_t<T>>>::is(mV);
     }
@@ -81,32 +93,35 @@ struct ChkNoNum
     template <>                                                             \
     struct Chk<mType> final                                                 \
     {                                                                       \
-        inline static auto is(const Val& mV) noexcept                       \
+        template <bool THashedObj, bool TCow>                               \
+        inline static auto is(const ValImpl<THashedObj, TCow>& mV) noexcept \
         {                                                                   \
-            return mV.getType() == Val::Type::TNum &&                       \
+            return mV.getType() == ValType::TNum &&                         \
                    mV.getNum().getRepr() == VRM_PP_DEFER(Num::Repr::mType); \
         }                                                                   \
     };
 
-#define SSVJ_DEFINE_CHK_BASIC(mType)                              \
-    template <>                                                   \
-    struct Chk<mType> final                                       \
-    {                                                             \
-        inline static auto is(const Val& mV) noexcept             \
-        {                                                         \
-            return mV.getType() ==                                \
-                   VRM_PP_DEFER(Val::Type::VRM_PP_CAT(T, mType)); \
-        }                                                         \
+#define SSVJ_DEFINE_CHK_BASIC(mName, mType)                                 \
+    template <>                                                             \
+    struct Chk<mType> final                                                 \
+    {                                                                       \
+        template <bool THashedObj, bool TCow>                               \
+        inline static auto is(const ValImpl<THashedObj, TCow>& mV) noexcept \
+        {                                                                   \
+            return mV.getType() ==                                          \
+                   VRM_PP_DEFER(ValType::VRM_PP_CAT(T, mName));             \
+        }                                                                   \
     };
 
-#define SSVJ_DEFINE_CHKNONUM(mType)                   \
-    template <>                                       \
-    struct ChkNoNum<mType>                            \
-    {                                                 \
-        inline static bool is(const Val& mV) noexcept \
-        {                                             \
-            return Chk<Num>::is(mV);                  \
-        }                                             \
+#define SSVJ_DEFINE_CHKNONUM(mType)                                         \
+    template <>                                                             \
+    struct ChkNoNum<mType>                                                  \
+    {                                                                       \
+        template <bool THashedObj, bool TCow>                               \
+        inline static bool is(const ValImpl<THashedObj, TCow>& mV) noexcept \
+        {                                                                   \
+            return Chk<Num>::is(mV);                                        \
+        }                                                                   \
     };
 
 // Define disallowed `is<...>` numeric type checks
@@ -122,12 +137,16 @@ SSVJ_DEFINE_CHK_NUM_REPR(IntU)
 SSVJ_DEFINE_CHK_NUM_REPR(Real)
 
 // Define basic checks
-SSVJ_DEFINE_CHK_BASIC(Obj)
-SSVJ_DEFINE_CHK_BASIC(Arr)
-SSVJ_DEFINE_CHK_BASIC(Str)
-SSVJ_DEFINE_CHK_BASIC(Num)
-SSVJ_DEFINE_CHK_BASIC(Bln)
-SSVJ_DEFINE_CHK_BASIC(Nll)
+SSVJ_DEFINE_CHK_BASIC(Obj, Val::Obj)
+SSVJ_DEFINE_CHK_BASIC(Obj, HashedVal::Obj)
+SSVJ_DEFINE_CHK_BASIC(Obj, CowVal::Obj)
+SSVJ_DEFINE_CHK_BASIC(Arr, Val::Arr)
+SSVJ_DEFINE_CHK_BASIC(Arr, HashedVal::Arr)
+SSVJ_DEFINE_CHK_BASIC(Arr, CowVal::Arr)
+SSVJ_DEFINE_CHK_BASIC(Str, Str)
+SSVJ_DEFINE_CHK_BASIC(Num, Num)
+SSVJ_DEFINE_CHK_BASIC(Bln, Bln)
+SSVJ_DEFINE_CHK_BASIC(Nll, Nll)
 
 // Define numeric type checks that ignore representation (always
 // return true if the `Val` is a `Num`)
@@ -146,10 +165,10 @@ SSVJ_DEFINE_CHKNONUM(double)
 #undef SSVJ_DEFINE_CHKNONUM
 
 // Check `Val` against itself
-template <>
-struct Chk<Val> final
+template <bool THashedObj, bool TCow>
+struct Chk<ValImpl<THashedObj, TCow>> final
 {
-    inline static bool is(const Val&) noexcept
+    inline static bool is(const ValImpl<THashedObj, TCow>&) noexcept
     {
         return true;
     }
@@ -159,9 +178,10 @@ struct Chk<Val> final
 template <std::size_t TS>
 struct Chk<char[TS]> final
 {
-    inline static auto is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static auto is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        return mV.getType() == Val::Type::TStr && mV.getStr().size() == TS;
+        return mV.getType() == ValType::TStr && mV.getStr().size() == TS;
     }
 };
 
@@ -169,9 +189,10 @@ struct Chk<char[TS]> final
 template <>
 struct Chk<const char*> final
 {
-    inline static auto is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static auto is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        return mV.getType() == Val::Type::TStr;
+        return mV.getType() == ValType::TStr;
     }
 };
 
@@ -179,10 +200,12 @@ struct Chk<const char*> final
 template <typename T1, typename T2>
 struct Chk<std::pair<T1, T2>> final
 {
-    inline static auto is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static auto is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        return mV.getType() == Val::Type::TArr && mV.getArr().size() == 2 &&
-               mV[0].isNoNum<T1>() && mV[1].isNoNum<T2>();
+        return mV.getType() == ValType::TArr && mV.getSizeArr() == 2 &&
+               mV[0].template isNoNum<T1>() &&
+               mV[1].template isNoNum<T2>();
     }
 };
 
@@ -190,10 +213,12 @@ struct Chk<std::pair<T1, T2>> final
 template <typename... TArgs>
 struct Chk<std::tuple<TArgs...>> final
 {
-    inline static auto SSVU_ATTRIBUTE(pure) is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static auto SSVU_ATTRIBUTE(pure)
+        is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        return mV.getType() == Val::Type::TArr &&
-               mV.getArr().size() == sizeof...(TArgs) &&
+        return mV.getType() == ValType::TArr &&
+               mV.getSizeArr() == sizeof...(TArgs) &&
                TplIsHelper::isTpl<0, TArgs...>(mV);
     }
 };
@@ -202,9 +227,11 @@ struct Chk<std::tuple<TArgs...>> final
 template <typename TItem>
 struct Chk<std::vector<TItem>> final
 {
-    inline static auto SSVU_ATTRIBUTE(pure) is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static auto SSVU_ATTRIBUTE(pure)
+        is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        return mV.getType() == Val::Type::TArr &&
+        return mV.getType() == ValType::TArr &&
                TplIsHelper::areArrItemsOfType<TItem>(mV);
     }
 };
@@ -213,9 +240,11 @@ struct Chk<std::vector<TItem>> final
 template <typename TItem, std::size_t TS>
 struct Chk<TItem[TS]> final
 {
-    inline static auto SSVU_ATTRIBUTE(pure) is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static auto SSVU_ATTRIBUTE(pure)
+        is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        return mV.getType() == Val::Type::TArr && mV.getArr().size() == TS &&
+        return mV.getType() == ValType::TArr && mV.getSizeArr() == TS &&
                TplIsHelper::areArrItemsOfType<TItem>(mV);
     }
 };
@@ -224,9 +253,10 @@ struct Chk<TItem[TS]> final
 template <std::size_t TS>
 struct Chk<std::bitset<TS>> final
 {
-    inline static auto is(const Val& mV) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static auto is(const ValImpl<THashedObj, TCow>& mV) noexcept
     {
-        return mV.getType() == Val::Type::TStr && mV.getStr().size() == TS;
+        return mV.getType() == ValType::TStr && mV.getStr().size() == TS;
     }
 };
 } // namespace Impl
@@ -19,49 +19,58 @@ namespace Json
 {
 namespace Impl
 {
-#define SSVJ_DEFINE_CNV_NUM(mType)                                    \
-    template <>                                                       \
-    struct Cnv<mType, void> final                                     \
-    {                                                                 \
-        inline static void toVal(Val& mV, const mType& mX) noexcept   \
-        {                                                             \
-            mV.setNum(Num{mX});                                       \
-        }                                                             \
-        inline static void fromVal(const Val& mV, mType& mX) noexcept \
-        {                                                             \
-            mX = mV.getNum().as<mType>();                             \
-        }                                                             \
+#define SSVJ_DEFINE_CNV_NUM(mType)                                   \
+    template <>                                                      \
+    struct Cnv<mType, void> final                                    \
+    {                                                                \
+        template <bool THashedObj, bool TCow>                        \
+        inline static void toVal(                                    \
+            ValImpl<THashedObj, TCow>& mV, const mType& mX) noexcept \
+        {                                                            \
+            mV.setNum(Num{mX});                                      \
+        }                                                            \
+        template <bool THashedObj, bool TCow>                        \
+        inline static void fromVal(                                  \
+            const ValImpl<THashedObj, TCow>& mV, mType& mX) noexcept \
+        {                                                            \
+            mX = mV.getNum().template as<mType>();                   \
+        }                                                            \
     };
 
-#define SSVJ_DEFINE_CNV_BIG_MUTABLE(mType)                                \
+#define SSVJ_DEFINE_CNV_BIG_MUTABLE(mName, mType)                         \
     template <>                                                           \
     struct Cnv<mType, void> final                                         \
     {                                                                     \
-        template <typename T>                                             \
-        inline static void toVal(Val& mV, T&& mX) noexcept(               \
-            noexcept(VRM_PP_CAT(mV.set, mType)(FWD(mX))))                 \
+        template <bool THashedObj, bool TCow, typename T>                 \
+        inline static void toVal(                                         \
+            ValImpl<THashedObj, TCow>& mV, T&& mX) noexcept(              \
+            noexcept(VRM_PP_CAT(mV.set, mName)(FWD(mX))))                 \
         {                                                                 \
-            VRM_PP_CAT(mV.set, mType)(FWD(mX));                           \
+            VRM_PP_CAT(mV.set, mName)(FWD(mX));                           \
         }                                                                 \
         template <typename T>                                             \
         inline static void fromVal(T&& mV, mType& mX)                     \
         {                                                                 \
-            mX = moveIfRValue<decltype(mV)>(VRM_PP_CAT(mV.get, mType)()); \
+            mX = moveIfRValue<decltype(mV)>(VRM_PP_CAT(mV.get, mName)()); \
         }                                                                 \
     };
 
-#define SSVJ_DEFINE_CNV_SMALL_IMMUTABLE(mType)                        \
-    template <>                                                       \
-    struct Cnv<mType, void> final                                     \
-    {                                                                 \
-        inline static void toVal(Val& mV, const mType& mX) noexcept   \
-        {                                                             \
-            VRM_PP_CAT(mV.set, mType)(mX);                            \
-        }                                                             \
-        inline static void fromVal(const Val& mV, mType& mX) noexcept \
-        {                                                             \
-            mX = VRM_PP_CAT(mV.get, mType)();                         \
-        }                                                             \
+#define SSVJ_DEFINE_CNV_SMALL_IMMUTABLE(mType)                       \
+    template <>                                                      \
+    struct Cnv<mType, void> final                                    \
+    {                                                                \
+        template <bool THashedObj, bool TCow>                        \
+        inline static void toVal(                                    \
+            ValImpl<THashedObj, TCow>& mV, const mType& mX) noexcept \
+        {                                                            \
+            VRM_PP_CAT(mV.set, mType)(mX);                           \
+        }                                                            \
+        template <bool THashedObj, bool TCow>                        \
+        inline static void fromVal(                                  \
+            const ValImpl<THashedObj, TCow>& mV, mType& mX) noexcept \
+        {                                                            \
+            mX = VRM_PP_CAT(mV.get, mType)();                        \
+        }                                                            \
     };
 
 // Define numeric value converters
@@ -75,10 +84,14 @@ SSVJ_DEFINE_CNV_NUM(float)
 SSVJ_DEFINE_CNV_NUM(double)
 
 // Define `Obj`, `Arr`, `Str` and `Num` converters
-SSVJ_DEFINE_CNV_BIG_MUTABLE(Obj)
-SSVJ_DEFINE_CNV_BIG_MUTABLE(Arr)
-SSVJ_DEFINE_CNV_BIG_MUTABLE(Str)
-SSVJ_DEFINE_CNV_BIG_MUTABLE(Num)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Obj, Val::Obj)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Obj, HashedVal::Obj)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Obj, CowVal::Obj)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Arr, Val::Arr)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Arr, HashedVal::Arr)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Arr, CowVal::Arr)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Str, Str)
+SSVJ_DEFINE_CNV_BIG_MUTABLE(Num, Num)
 
 // Define other converters
 SSVJ_DEFINE_CNV_SMALL_IMMUTABLE(Bln)
@@ -89,11 +102,11 @@ SSVJ_DEFINE_CNV_SMALL_IMMUTABLE(Nll)
 #undef SSVJ_DEFINE_CNV_SMALL_IMMUTABLE
 
 // Convert values to themselves
-template <>
-struct Cnv<Val, void> final
+template <bool THashedObj, bool TCow>
+struct Cnv<ValImpl<THashedObj, TCow>, void> final
 {
     template <typename T>
-    inline static void toVal(Val& mV, T&& mX) noexcept(
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, T&& mX) noexcept(
         noexcept(mV.init(FWD(mX))))
     {
         mV.init(FWD(mX));
@@ -111,11 +124,15 @@ struct Cnv<T, std::enable_if_t<
                   std::is_enum_v<std::remove_cv_t<std::remove_reference_t<T>>>>>
     final
 {
-    inline static void toVal(Val& mV, const T& mX) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static void toVal(
+        ValImpl<THashedObj, TCow>& mV, const T& mX) noexcept
     {
         mV = std::underlying_type_t<T>(mX);
     }
-    inline static void fromVal(const Val& mV, T& mX) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static void fromVal(
+        const ValImpl<THashedObj, TCow>& mV, T& mX) noexcept
     {
         mX = T(mV.template as<std::underlying_type_t<T>>());
     }
@@ -125,11 +142,15 @@ struct Cnv<T, std::enable_if_t<
 template <std::size_t TS>
 struct Cnv<char[TS]> final
 {
-    inline static void toVal(Val& mV, const char (&mX)[TS])
+    template <bool THashedObj, bool TCow>
+    inline static void toVal(
+        ValImpl<THashedObj, TCow>& mV, const char (&mX)[TS])
     {
         mV.setStr(mX);
     }
-    inline static void fromVal(const Val& mV, char (&mX)[TS]) noexcept
+    template <bool THashedObj, bool TCow>
+    inline static void fromVal(
+        const ValImpl<THashedObj, TCow>& mV, char (&mX)[TS]) noexcept
     {
         for(auto i(0u); i < TS; ++i) mX[i] = mV.getStr()[i];
     }
@@ -139,7 +160,8 @@ struct Cnv<char[TS]> final
 template <>
 struct Cnv<const char*> final
 {
-    inline static void toVal(Val& mV, const char* mX)
+    template <bool THashedObj, bool TCow>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, const char* mX)
     {
         mV.setStr(mX);
     }
@@ -151,11 +173,12 @@ struct Cnv<std::pair<T1, T2>> final
 {
     using Type = std::pair<T1, T2>;
 
-    template <typename T>
-    inline static void toVal(Val& mV, T&& mX)
+    template <bool THashedObj, bool TCow, typename T>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, T&& mX)
     {
-        mV.setArr(Arr{Val{moveIfRValue<decltype(mX)>(mX.first)},
-            Val{moveIfRValue<decltype(mX)>(mX.second)}});
+        using V = ValImpl<THashedObj, TCow>;
+        mV.setArr(typename V::Arr{V{moveIfRValue<decltype(mX)>(mX.first)},
+            V{moveIfRValue<decltype(mX)>(mX.second)}});
     }
     template <typename T>
     inline static void fromVal(T&& mV, Type& mX)
@@ -171,10 +194,10 @@ struct Cnv<std::tuple<TArgs...>> final
 {
     using Type = std::tuple<TArgs...>;
 
-    template <typename T>
-    inline static void toVal(Val& mV, T&& mX)
+    template <bool THashedObj, bool TCow, typename T>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, T&& mX)
     {
-        Arr result;
+        typename ValImpl<THashedObj, TCow>::Arr result;
         result.reserve(sizeof...(TArgs));
         tplFor([&result](auto&& mI) { result.emplace_back(FWD(mI)); }, FWD(mX));
         mV.setArr(std::move(result));
@@ -185,7 +208,7 @@ struct Cnv<std::tuple<TArgs...>> final
         tplForData(
             [&mV](auto mD, auto& mE) {
                 assert(
-                    mV.template is<Arr>() && mV.getArr().size() > mD.getIdx());
+                    mV.template is<Arr>() && mV.getSizeArr() > mD.getIdx());
                 mE = moveIfRValue<decltype(mV)>(
                     FWD(mV)[mD.getIdx()]
                         .template as<std::remove_reference_t<decltype(mE)>>());
@@ -200,10 +223,10 @@ struct Cnv<std::vector<TItem>> final
 {
     using Type = std::vector<TItem>;
 
-    template <typename T>
-    inline static void toVal(Val& mV, T&& mX)
+    template <bool THashedObj, bool TCow, typename T>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, T&& mX)
     {
-        Arr result;
+        typename ValImpl<THashedObj, TCow>::Arr result;
         result.reserve(mX.size());
         for(const auto& v : mX)
             result.emplace_back(moveIfRValue<decltype(mX)>(v));
@@ -212,6 +235,14 @@ struct Cnv<std::vector<TItem>> final
     template <typename T>
     inline static void fromVal(T&& mV, Type& mX)
     {
+        // Numeric arrays are converted without building an `Arr`
+        if constexpr(std::is_arithmetic_v<TItem> &&
+                     !std::is_same_v<TItem, Bln>)
+            if(mV.visitNumArr([&](const auto& mItems) {
+                   mX.assign(std::begin(mItems), std::end(mItems));
+               }))
+                return;
+
         const auto& arr(mV.getArr());
         mX.reserve(arr.size());
         mX.clear();
@@ -230,10 +261,10 @@ struct Cnv<TMap<TKey, TValue, TExtra...>,
 {
     using Type = TMap<TKey, TValue, TExtra...>;
 
-    template <typename T>
-    inline static void toVal(Val& mVal, T&& mX)
+    template <bool THashedObj, bool TCow, typename T>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mVal, T&& mX)
     {
-        mVal = Arr{};
+        mVal = typename ValImpl<THashedObj, TCow>::Arr{};
         for(auto& p : mX)
             mVal.getArr().emplace_back(moveIfRValue<decltype(mX)>(p));
     }
@@ -253,10 +284,10 @@ struct Cnv<TItem[TS]>
 {
     using Type = TItem[TS];
 
-    template <typename T>
-    inline static void toVal(Val& mV, T&& mX)
+    template <bool THashedObj, bool TCow, typename T>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, T&& mX)
     {
-        Arr result;
+        typename ValImpl<THashedObj, TCow>::Arr result;
         result.reserve(TS);
         for(auto i(0u); i < TS; ++i)
             result.emplace_back(moveIfRValue<decltype(mX)>(mX[i]));
@@ -265,7 +296,7 @@ struct Cnv<TItem[TS]>
     template <typename T>
     inline static void fromVal(T&& mV, Type& mX)
     {
-        assert(mV.getArr().size() >= TS);
+        assert(mV.getSizeArr() >= TS);
         for(auto i(0u); i < TS; ++i)
             mX[i] = moveIfRValue<decltype(mV)>(mV[i].template as<TItem>());
     }
@@ -277,8 +308,8 @@ struct Cnv<std::bitset<TS>>
 {
     using Type = std::bitset<TS>;
 
-    template <typename T>
-    inline static void toVal(Val& mV, T&& mX)
+    template <bool THashedObj, bool TCow, typename T>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, T&& mX)
     {
         mV = mX.to_string();
     }
@@ -293,21 +324,26 @@ struct Cnv<std::bitset<TS>>
 template <typename T>
 struct CnvImplSimple
 {
-    inline static void toVal(Val& mV, const T& mX)
+    template <bool THashedObj, bool TCow>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, const T& mX)
     {
         Cnv<T>::template impl<decltype(mV), decltype(mX)>(mV, mX);
     }
-    inline static void toVal(Val& mV, T&& mX)
+    template <bool THashedObj, bool TCow>
+    inline static void toVal(ValImpl<THashedObj, TCow>& mV, T&& mX)
     {
-        Cnv<T>::template impl<decltype(mV), decltype(mX)>(mV, mX);
+        toVal(mV, static_cast<const T&>(mX));
     }
-    inline static void fromVal(const Val& mV, T& mX)
+    template <bool THashedObj, bool TCow>
+    inline static void fromVal(const ValImpl<THashedObj, TCow>& mV, T& mX)
     {
         Cnv<T>::template impl<decltype(mV), decltype(mX)>(mV, mX);
     }
-    inline static void fromVal(Val&& mV, T& mX)
+    template <bool THashedObj, bool TCow>
+    inline static void fromVal(ValImpl<THashedObj, TCow>&& mV, T& mX)
     {
-        Cnv<T>::template impl<decltype(mV), decltype(mX)>(mV, mX);
+        // A named `Val&&` would select the archiving `cnv` overloads
+        fromVal(static_cast<const ValImpl<THashedObj, TCow>&>(mV), mX);
     }
 };
 } // namespace Impl
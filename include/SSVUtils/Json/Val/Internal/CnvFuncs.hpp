@@ -16,12 +16,15 @@ namespace Json
 {
 template <typename T, typename TFwd>
 inline void extr(TFwd&& mV, T& mX) noexcept(
-    noexcept(Impl::Cnv<std::remove_cv_t<std::remove_reference_t<T>>>::fromVal(FWD(mV), mX)))
+    noexcept(Impl::Cnv<std::remove_cv_t<std::remove_reference_t<T>>>::fromVal(
+        Impl::fwdCnvSrc(FWD(mV)), mX)))
 {
-    Impl::Cnv<std::remove_cv_t<std::remove_reference_t<T>>>::fromVal(FWD(mV), mX);
+    Impl::Cnv<std::remove_cv_t<std::remove_reference_t<T>>>::fromVal(
+        Impl::fwdCnvSrc(FWD(mV)), mX);
 }
-template <typename T>
-inline void arch(Val& mV, T&& mX) noexcept(noexcept(mV = FWD(mX)))
+template <bool THashedObj, bool TCow, typename T>
+inline void arch(Impl::ValImpl<THashedObj, TCow>& mV, T&& mX) noexcept(
+    noexcept(mV = FWD(mX)))
 {
     mV = FWD(mX);
 }
@@ -33,8 +36,7 @@ struct CnvFuncHelper
     template <Idx TI, typename TArg, typename T>
     inline static void hExtrArr(T&& mV, TArg& mArg)
     {
-        assert(mV.template is<Arr>() &&
-                    mV.template as<Arr>().size() > TI &&
+        assert(mV.template is<Arr>() && mV.getSizeArr() > TI &&
                     mV[TI].template isNoNum<TArg>());
         extr<TArg>(moveIfRValue<decltype(mV)>(mV[TI]), mArg);
     }
@@ -45,14 +47,16 @@ struct CnvFuncHelper
         hExtrArr<TI + 1>(FWD(mV), mArgs...);
     }
 
-    template <Idx TI, typename TArg>
-    inline static void hArchArr(Val& mV, TArg&& mArg)
+    template <Idx TI, typename TArg, bool THashedObj, bool TCow>
+    inline static void hArchArr(ValImpl<THashedObj, TCow>& mV, TArg&& mArg)
     {
         assert(mV.template is<Arr>());
         mV.emplace(FWD(mArg));
     }
-    template <Idx TI, typename TArg, typename... TArgs>
-    inline static void hArchArr(Val& mV, TArg&& mArg, TArgs&&... mArgs)
+    template <Idx TI, typename TArg, typename... TArgs, bool THashedObj,
+        bool TCow>
+    inline static void hArchArr(
+        ValImpl<THashedObj, TCow>& mV, TArg&& mArg, TArgs&&... mArgs)
     {
         hArchArr<TI>(mV, FWD(mArg));
         hArchArr<TI + 1>(mV, FWD(mArgs)...);
@@ -72,15 +76,17 @@ struct CnvFuncHelper
         hExtrObj(FWD(mV), mArgs...);
     }
 
-    template <typename TKey, typename TArg>
-    inline static void hArchObj(Val& mV, TKey&& mKey, TArg&& mArg)
+    template <typename TKey, typename TArg, bool THashedObj, bool TCow>
+    inline static void hArchObj(
+        ValImpl<THashedObj, TCow>& mV, TKey&& mKey, TArg&& mArg)
     {
         assert(mV.template is<Obj>());
         arch(mV[FWD(mKey)], FWD(mArg));
     }
-    template <typename TKey, typename TArg, typename... TArgs>
-    inline static void hArchObj(
-        Val& mV, TKey&& mKey, TArg&& mArg, TArgs&&... mArgs)
+    template <typename TKey, typename TArg, typename... TArgs,
+        bool THashedObj, bool TCow>
+    inline static void hArchObj(ValImpl<THashedObj, TCow>& mV, TKey&& mKey,
+        TArg&& mArg, TArgs&&... mArgs)
     {
         hArchObj(mV, FWD(mKey), FWD(mArg));
         hArchObj(mV, FWD(mArgs)...);
@@ -106,12 +112,12 @@ inline Val getArch(T&& mX)
 template <typename... TArgs, typename T>
 inline void extrArr(T&& mV, TArgs&... mArgs)
 {
-    Impl::CnvFuncHelper::hExtrArr<0>(FWD(mV), mArgs...);
+    Impl::CnvFuncHelper::hExtrArr<0>(Impl::fwdCnvSrc(FWD(mV)), mArgs...);
 }
-template <typename... TArgs>
-inline void archArr(Val& mV, TArgs&&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void archArr(Impl::ValImpl<THashedObj, TCow>& mV, TArgs&&... mArgs)
 {
-    mV = Impl::Arr{};
+    mV = typename Impl::ValImpl<THashedObj, TCow>::Arr{};
     Impl::CnvFuncHelper::hArchArr<0>(mV, FWD(mArgs)...);
 }
 template <typename... TArgs>
@@ -125,12 +131,12 @@ inline Val getArchArr(TArgs&&... mArgs)
 template <typename... TArgs, typename T>
 inline void extrObj(T&& mV, TArgs&... mArgs)
 {
-    Impl::CnvFuncHelper::hExtrObj(FWD(mV), mArgs...);
+    Impl::CnvFuncHelper::hExtrObj(Impl::fwdCnvSrc(FWD(mV)), mArgs...);
 }
-template <typename... TArgs>
-inline void archObj(Val& mV, TArgs&&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void archObj(Impl::ValImpl<THashedObj, TCow>& mV, TArgs&&... mArgs)
 {
-    mV = Impl::Obj{};
+    mV = typename Impl::ValImpl<THashedObj, TCow>::Obj{};
     Impl::CnvFuncHelper::hArchObj(mV, FWD(mArgs)...);
 }
 template <typename... TArgs>
@@ -141,50 +147,53 @@ inline Val getArchObj(TArgs&&... mArgs)
     return result;
 }
 
-template <typename T>
-inline void cnv(const Val& mV, T& mX) noexcept(noexcept(extr(mV, mX)))
+template <bool THashedObj, bool TCow, typename T>
+inline void cnv(const Impl::ValImpl<THashedObj, TCow>& mV, T& mX) noexcept(
+    noexcept(extr(mV, mX)))
 {
     extr(mV, mX);
 }
-template <typename T>
-inline void cnv(Val&& mV, T& mX) noexcept(noexcept(extr(std::move(mV), mX)))
+template <bool THashedObj, bool TCow, typename T>
+inline void cnv(Impl::ValImpl<THashedObj, TCow>&& mV, T& mX) noexcept(
+    noexcept(extr(std::move(mV), mX)))
 {
     extr(std::move(mV), mX);
 }
-template <typename T>
-inline void cnv(Val& mV, T&& mX) noexcept(noexcept(arch(mV, FWD(mX))))
+template <bool THashedObj, bool TCow, typename T>
+inline void cnv(Impl::ValImpl<THashedObj, TCow>& mV, T&& mX) noexcept(
+    noexcept(arch(mV, FWD(mX))))
 {
     arch(mV, FWD(mX));
 }
 
-template <typename... TArgs>
-inline void cnvArr(const Val& mV, TArgs&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void cnvArr(const Impl::ValImpl<THashedObj, TCow>& mV, TArgs&... mArgs)
 {
     extrArr(mV, mArgs...);
 }
-template <typename... TArgs>
-inline void cnvArr(Val&& mV, TArgs&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void cnvArr(Impl::ValImpl<THashedObj, TCow>&& mV, TArgs&... mArgs)
 {
     extrArr(std::move(mV), mArgs...);
 }
-template <typename... TArgs>
-inline void cnvArr(Val& mV, TArgs&&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void cnvArr(Impl::ValImpl<THashedObj, TCow>& mV, TArgs&&... mArgs)
 {
     archArr(mV, FWD(mArgs)...);
 }
 
-template <typename... TArgs>
-inline void cnvObj(const Val& mV, TArgs&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void cnvObj(const Impl::ValImpl<THashedObj, TCow>& mV, TArgs&... mArgs)
 {
     extrObj(mV, mArgs...);
 }
-template <typename... TArgs>
-inline void cnvObj(Val&& mV, TArgs&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void cnvObj(Impl::ValImpl<THashedObj, TCow>&& mV, TArgs&... mArgs)
 {
     extrObj(std::move(mV), mArgs...);
 }
-template <typename... TArgs>
-inline void cnvObj(Val& mV, TArgs&&... mArgs)
+template <typename... TArgs, bool THashedObj, bool TCow>
+inline void cnvObj(Impl::ValImpl<THashedObj, TCow>& mV, TArgs&&... mArgs)
 {
     archObj(mV, FWD(mArgs)...);
 }
@@ -40,6 +40,13 @@
         template <typename TV, typename TX>        \
         inline static void impl(TV mVName, TX mXName)
 
+/// @macro Marks a converter as streamable, allowing it to be read directly
+/// from the source by `extrFromStr`, without building a `Val`.
+/// @details Must be called after the body of `SSVJ_CNV`, before
+/// `SSVJ_CNV_END`. Only valid if the body exclusively uses `cnv`, `cnvArr`
+/// and `cnvObj` on `mV`. Semicolon must not be used.
+#define SSVJ_CNV_STREAMABLE() static constexpr bool streamable{true};
+
 /// @macro End macro, required after defining a converter.
 /// @details Semicolon must not be used.
 #define SSVJ_CNV_END() \
@@ -63,8 +70,8 @@
 // Wrapper macro to avoid repetition
 #define SSVJ_IMPL_CNV_WRAPPER(mType, mTemplateArgs, mBody)            \
     SSVJ_CNV_NAMESPACE(){template <VRM_PP_TPL_EXPLODE(mTemplateArgs)> \
-        SSVJ_CNV(mType, mV, mX){VRM_PP_TPL_EXPLODE(                   \
-            mBody)} SSVJ_CNV_END()} SSVJ_CNV_NAMESPACE_END()
+        SSVJ_CNV(mType, mV, mX){VRM_PP_TPL_EXPLODE(mBody)}            \
+            SSVJ_CNV_STREAMABLE() SSVJ_CNV_END()} SSVJ_CNV_NAMESPACE_END()
 
 /// @macro Serialize/deserialize the specified member `mArg` of `mX` to a JSON
 /// value in `mV`.
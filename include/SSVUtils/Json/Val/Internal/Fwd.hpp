@@ -14,7 +14,8 @@ namespace Json
 namespace Impl
 {
 // `Val` forward declaration.
-class Val;
+template <bool, bool>
+class ValImpl;
 
 /// @brief Helper class to convert C++ objects to/from `Val`.
 template <typename, typename>
@@ -88,16 +88,10 @@ struct ItrHelper
     }
 
     // Empty range creation helper functions
-    template <typename T = Val>
-    inline static auto& getEmptyObj() noexcept
-    {
-        static ObjImpl<T> result;
-        return result;
-    }
-    template <typename T = Val>
-    inline static auto& getEmptyArr() noexcept
+    template <typename T>
+    inline static auto& getEmpty() noexcept
     {
-        static ArrImpl<T> result;
+        static T result;
         return result;
     }
 };
@@ -0,0 +1,370 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_JSON_VAL_PATCH
+#define SSVU_JSON_VAL_PATCH
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Common/Common.hpp"
+#include "SSVUtils/Json/Val/Val.hpp"
+#include "SSVUtils/Json/Io/Pointer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ssvu
+{
+namespace Json
+{
+namespace Impl
+{
+/// @brief Collects the operations turning a `TV` value into another one.
+template <typename TV>
+class Differ
+{
+private:
+    using Obj = typename TV::Obj;
+    using Arr = typename TV::Arr;
+
+    Arr ops;
+
+    /// @brief Pointer to the values being compared.
+    std::string path;
+
+    inline Obj makeOp(const char* mOp)
+    {
+        Obj result;
+        result.reserve(3);
+        result["op"] = mOp;
+        result["path"] = path;
+        return result;
+    }
+
+    inline void addOp(const char* mOp)
+    {
+        ops.emplace_back(makeOp(mOp));
+    }
+    inline void addOp(const char* mOp, const TV& mX)
+    {
+        auto op(makeOp(mOp));
+        op["value"] = mX;
+        ops.emplace_back(std::move(op));
+    }
+
+    inline void pushIdx(std::size_t mIdx)
+    {
+        char buf[24];
+        const auto end(std::to_chars(buf, buf + sizeof(buf), mIdx).ptr);
+        appendPointerToken(path, std::string_view(buf, end - buf));
+    }
+
+    inline void diffObj(const Obj& mFrom, const Obj& mTo)
+    {
+        const auto size(path.size());
+
+        for(const auto& p : mFrom)
+        {
+            appendPointerToken(path, p.first);
+
+            const auto itr(mTo.atItr(p.first));
+            if(itr == std::end(mTo))
+                addOp("remove");
+            else
+                diff(p.second, itr->second);
+
+            path.resize(size);
+        }
+
+        for(const auto& p : mTo)
+        {
+            if(mFrom.count(p.first) != 0) continue;
+
+            appendPointerToken(path, p.first);
+            addOp("add", p.second);
+            path.resize(size);
+        }
+    }
+
+    inline void diffArr(const Arr& mFrom, const Arr& mTo)
+    {
+        const auto size(path.size());
+        const auto common(std::min(mFrom.size(), mTo.size()));
+
+        for(auto i(0u); i < common; ++i)
+        {
+            pushIdx(i);
+            diff(mFrom[i], mTo[i]);
+            path.resize(size);
+        }
+
+        for(auto i(common); i < mTo.size(); ++i)
+        {
+            pushIdx(i);
+            addOp("add", mTo[i]);
+            path.resize(size);
+        }
+
+        // Remove from the back, so that indices stay valid
+        for(auto i(mFrom.size()); i-- > common;)
+        {
+            pushIdx(i);
+            addOp("remove");
+            path.resize(size);
+        }
+    }
+
+public:
+    inline void diff(const TV& mFrom, const TV& mTo)
+    {
+        // Identical or shared subtrees cannot differ
+        if(mFrom.sharesStorageWith(mTo)) return;
+
+        const auto type(mFrom.getType());
+        if(type != mTo.getType())
+            addOp("replace", mTo);
+        else if(type == ValType::TObj)
+            diffObj(mFrom.template as<Obj>(), mTo.template as<Obj>());
+        else if(type == ValType::TArr)
+            diffArr(mFrom.template as<Arr>(), mTo.template as<Arr>());
+        else if(mFrom != mTo)
+            addOp("replace", mTo);
+    }
+
+    inline auto& getOps() noexcept
+    {
+        return ops;
+    }
+};
+
+/// @brief Applies single patch operations to a `TV` value.
+template <typename TV>
+class Patcher
+{
+private:
+    using Obj = typename TV::Obj;
+    using Arr = typename TV::Arr;
+
+    TV& root;
+
+    [[noreturn]] inline static void fail(const std::string& mMsg)
+    {
+        throw std::runtime_error{"JSON patch: " + mMsg};
+    }
+
+    /// @brief Returns the index of an array of size `mSize` described by
+    /// `mToken`.
+    /// @details If `mAllowEnd` is true, the index may be one past the last
+    /// element, which `-` also describes.
+    inline static Idx getIdx(
+        std::size_t mSize, const std::string& mToken, bool mAllowEnd)
+    {
+        if(mAllowEnd && mToken == "-") return mSize;
+
+        Idx result{0};
+        if(!parseIdxToken(mToken, result) || result > mSize ||
+            (!mAllowEnd && result == mSize))
+            fail("invalid array index `" + mToken + "'");
+
+        return result;
+    }
+
+    /// @brief Returns the child of `mV` described by `mToken`.
+    /// @details Const values are only read, so that values shared with
+    /// copies are not cloned.
+    template <typename T>
+    inline static T& getChild(T& mV, const std::string& mToken)
+    {
+        if(mV.template is<Obj>())
+        {
+            if(!mV.has(mToken)) fail("missing key `" + mToken + "'");
+            return mV[mToken];
+        }
+
+        if(mV.template is<Arr>())
+            return mV[getIdx(mV.getSizeArr(), mToken, false)];
+
+        fail("cannot find `" + mToken + "' in a non-container value");
+    }
+
+    /// @brief Returns the value containing the one at `mTokens`.
+    inline TV& getParent(const std::vector<std::string>& mTokens)
+    {
+        auto v(&root);
+        for(auto i(0u); i + 1 < mTokens.size(); ++i)
+            v = &getChild(*v, mTokens[i]);
+
+        return *v;
+    }
+
+    inline TV& get(const std::vector<std::string>& mTokens)
+    {
+        if(mTokens.empty()) return root;
+        return getChild(getParent(mTokens), mTokens.back());
+    }
+
+    inline const TV& find(const std::vector<std::string>& mTokens) const
+    {
+        const TV* v(&root);
+        for(const auto& t : mTokens) v = &getChild(*v, t);
+
+        return *v;
+    }
+
+public:
+    inline Patcher(TV& mRoot) noexcept : root{mRoot}
+    {
+    }
+
+    inline void add(const std::vector<std::string>& mTokens, TV mX)
+    {
+        if(mTokens.empty())
+        {
+            root = std::move(mX);
+            return;
+        }
+
+        auto& parent(getParent(mTokens));
+        const auto& last(mTokens.back());
+
+        if(parent.template is<Obj>())
+            parent[last] = std::move(mX);
+        else if(parent.template is<Arr>())
+        {
+            auto& arr(parent.template as<Arr>());
+            arr.emplace(std::begin(arr) + getIdx(arr.size(), last, true),
+                std::move(mX));
+        }
+        else
+            fail("cannot add `" + last + "' to a non-container value");
+    }
+
+    /// @brief Removes the value at `mTokens`, returning it.
+    inline TV remove(const std::vector<std::string>& mTokens)
+    {
+        if(mTokens.empty()) fail("cannot remove the whole document");
+
+        auto& parent(getParent(mTokens));
+        const auto& last(mTokens.back());
+        TV result{std::move(getChild(parent, last))};
+
+        if(parent.template is<Obj>())
+            parent.template as<Obj>().erase(last);
+        else
+        {
+            auto& arr(parent.template as<Arr>());
+            arr.erase(std::begin(arr) + getIdx(arr.size(), last, false));
+        }
+
+        return result;
+    }
+
+    inline void replace(const std::vector<std::string>& mTokens, TV mX)
+    {
+        get(mTokens) = std::move(mX);
+    }
+
+    inline void move(const std::vector<std::string>& mFrom,
+        const std::vector<std::string>& mTo)
+    {
+        if(mFrom.size() < mTo.size() &&
+            std::equal(std::begin(mFrom), std::end(mFrom), std::begin(mTo)))
+            fail("cannot move a value into one of its children");
+
+        add(mTo, remove(mFrom));
+    }
+
+    inline void copy(const std::vector<std::string>& mFrom,
+        const std::vector<std::string>& mTo)
+    {
+        add(mTo, find(mFrom));
+    }
+
+    inline void test(const std::vector<std::string>& mTokens, const TV& mX)
+    {
+        if(find(mTokens) != mX) fail("test failed");
+    }
+
+    /// @brief Applies the operation `mOp`.
+    inline void apply(const TV& mOp)
+    {
+        if(!mOp.template is<Obj>()) fail("operations must be objects");
+
+        auto getMember([&](const char* mName) -> const TV& {
+            if(!mOp.has(mName))
+                fail("missing `" + std::string{mName} + "' member");
+
+            return mOp[mName];
+        });
+        auto getStr([&](const char* mName) -> const Str& {
+            const auto& v(getMember(mName));
+            if(!v.template is<Str>())
+                fail("`" + std::string{mName} + "' must be a string");
+
+            return v.template as<Str>();
+        });
+        auto getTokens([&](const char* mName) {
+            return Pointer::fromStr(getStr(mName)).getTokens();
+        });
+
+        const auto& op(getStr("op"));
+        const auto tokens(getTokens("path"));
+
+        if(op == "add")
+            add(tokens, getMember("value"));
+        else if(op == "remove")
+            remove(tokens);
+        else if(op == "replace")
+            replace(tokens, getMember("value"));
+        else if(op == "move")
+            move(getTokens("from"), tokens);
+        else if(op == "copy")
+            copy(getTokens("from"), tokens);
+        else if(op == "test")
+            test(tokens, getMember("value"));
+        else
+            fail("unknown operation `" + op + "'");
+    }
+};
+} // namespace Impl
+
+/// @brief Returns the RFC 6902 patch turning `mFrom` into `mTo`.
+/// @details Only differing values are visited by the patch: unchanged
+/// subtrees do not appear in it. Array elements are compared by position,
+/// so an element inserted in the middle of an array replaces the following
+/// ones.
+template <bool TCow>
+inline auto diff(const Impl::ValImpl<false, TCow>& mFrom,
+    const Impl::ValImpl<false, TCow>& mTo)
+{
+    using V = Impl::ValImpl<false, TCow>;
+
+    Impl::Differ<V> d;
+    d.diff(mFrom, mTo);
+    return V{std::move(d.getOps())};
+}
+
+/// @brief Applies the RFC 6902 patch `mPatch` to `mV`, in place.
+/// @details Supports the `add`, `remove`, `replace`, `move`, `copy` and
+/// `test` operations. The cost is proportional to the number of patched
+/// values, not to the size of `mV`. Throws `std::runtime_error` if an
+/// operation fails, in which case the previous operations stay applied.
+template <bool TCow>
+inline void applyPatch(
+    Impl::ValImpl<false, TCow>& mV, const Impl::ValImpl<false, TCow>& mPatch)
+{
+    using V = Impl::ValImpl<false, TCow>;
+
+    if(!mPatch.template is<typename V::Arr>())
+        throw std::runtime_error{"JSON patch: patch must be an array"};
+
+    Impl::Patcher<V> p{mV};
+    for(const auto& op : mPatch.template as<typename V::Arr>()) p.apply(op);
+}
+} // namespace Json
+} // namespace ssvu
+
+#endif
@@ -16,9 +16,15 @@
 #include <vrm/pp.hpp>
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <fstream>
+#include <cstdio>
+#include <atomic>
+#include <cstdint>
 #include <cassert>
+#include <type_traits>
+#include <utility>
 
 namespace ssvu
 {
@@ -26,7 +32,31 @@ namespace Json
 {
 namespace Impl
 {
-class Val
+/// @brief Internal storage type of `Val`.
+enum class ValType
+{
+    TObj,
+    TArr,
+    TStr,
+    TNum,
+    TBln,
+    TNll
+};
+
+/// @brief JSON value.
+/// @tparam THashedObj If true, objects keep their keys in insertion order,
+/// with a hash index for wide objects: key insertion and lookup become
+/// O(1). Otherwise they are sorted by key.
+/// @tparam TCow If true, copies of a value share its objects, arrays and
+/// strings, which are cloned only when mutated.
+/// @details A single tag byte holds both the type and the representation
+/// of numbers. Only copy-on-write values have the compact 16-byte layout:
+/// they store a tag and a scalar or a pointer to a box. Other values store
+/// objects, arrays and strings in place, taking `sizeof(Str) + 8` bytes
+/// (40 bytes with libstdc++). Strings are `Str`: short strings are only
+/// stored inline through its own small-string buffer.
+template <bool THashedObj, bool TCow>
+class ValImpl
 {
     template <typename, typename>
     friend struct Impl::Cnv;
@@ -39,101 +69,515 @@ class Val
     friend struct Impl::CnvFuncHelper;
 
 public:
-    /// @brief Internal storage type.
-    enum class Type
-    {
-        TObj,
-        TArr,
-        TStr,
-        TNum,
-        TBln,
-        TNll
-    };
+    /// @typedef Internal storage type.
+    using Type = ValType;
 
     /// @typedef `Obj` implementation type, templatized with `Val`.
-    using Obj = Impl::ObjImpl<Val>;
+    using Obj = Impl::ObjImpl<ValImpl, THashedObj>;
 
     /// @typedef `Arr` implementation type, templatized with `Val`.
-    using Arr = Impl::ArrImpl<Val>;
+    using Arr = Impl::ArrImpl<ValImpl>;
 
 private:
     // Shortcut typedefs
     using Num = Impl::Num;
     using VIH = Impl::ItrHelper;
 
-    /// @brief Current storage type.
-    Type type{Type::TNll};
+public:
+    /// @brief Minimum size of the arrays stored as numeric arrays by
+    /// readers that enable them.
+    static constexpr std::size_t numArrThreshold{16};
+
+private:
+    // Storage tags, following the values of `Num::Repr`
+    static constexpr std::uint8_t tagObj{3};
+    static constexpr std::uint8_t tagArr{4};
+    static constexpr std::uint8_t tagStr{5};
+    static constexpr std::uint8_t tagBln{6};
+    static constexpr std::uint8_t tagNll{7};
+    static constexpr std::uint8_t tagNumArrIntS{8};
+    static constexpr std::uint8_t tagNumArrReal{9};
+
+    /// @brief Reference count of the boxes of copy-on-write values.
+    /// @details Copies of a value share its boxes, counting their
+    /// references. Shared boxes are cloned before being mutated. Once
+    /// mutated, a box is not shared anymore, as references to its contents
+    /// may have escaped: copying it clones it again, but its children are
+    /// still shared.
+    struct BoxRefs
+    {
+        /// @brief Number of values sharing the box, or zero if it cannot
+        /// be shared.
+        std::atomic<std::uint32_t> refs{1};
+    };
+
+    /// @brief Empty base of the boxes of other values, which are never
+    /// shared.
+    struct BoxNoRefs
+    {
+    };
+
+    /// @brief Heap storage of the values that are not stored in place.
+    template <typename T>
+    struct Box : std::conditional_t<TCow, BoxRefs, BoxNoRefs>
+    {
+        T x;
+
+        template <typename... TArgs>
+        inline Box(TArgs&&... mArgs) : x(FWD(mArgs)...)
+        {
+        }
+    };
+
+    /// @brief Storage of homogeneous numeric arrays.
+    /// @details Items are stored contiguously. Accessing them as a
+    /// regular `Arr` through a const `Val` builds a copy once, which is
+    /// published atomically, so concurrent readers are safe. Mutable
+    /// access converts the value to a regular `Arr`.
+    template <typename T>
+    struct NumArr
+    {
+        std::vector<T> items;
+        mutable std::atomic<Arr*> arr{nullptr};
+
+        inline NumArr(std::vector<T>&& mItems) noexcept
+            : items{std::move(mItems)}
+        {
+        }
+        inline NumArr(const NumArr& mX) : items{mX.items}
+        {
+        }
+        inline ~NumArr()
+        {
+            delete arr.load(std::memory_order_relaxed);
+        }
+
+        inline const Arr& getArr() const
+        {
+            if(auto p = arr.load(std::memory_order_acquire)) return *p;
+
+            auto result(new Arr(std::begin(items), std::end(items)));
+            Arr* expected{nullptr};
+            if(arr.compare_exchange_strong(expected, result,
+                   std::memory_order_acq_rel, std::memory_order_acquire))
+                return *result;
+
+            // Another thread built it first
+            delete result;
+            return *expected;
+        }
+
+        /// @brief Returns a regular `Arr` holding the items.
+        inline Arr toArr()
+        {
+            if(auto p = arr.exchange(nullptr, std::memory_order_relaxed))
+            {
+                Arr result(std::move(*p));
+                delete p;
+                return result;
+            }
+
+            return Arr(std::begin(items), std::end(items));
+        }
+    };
+
+    /// @brief True if `T` is stored in place, instead of being boxed.
+    /// @details Values that are not copy-on-write store `Obj`, `Arr` and
+    /// `Str` in place when they fit in a `Str`, so that reading them
+    /// allocates nothing but their contents. Copy-on-write values box
+    /// everything, as boxes are what copies share.
+    template <typename T>
+    static constexpr bool isInPlace{!TCow && sizeof(T) <= sizeof(Str) &&
+                                    alignof(T) <= alignof(Str) &&
+                                    std::is_nothrow_move_constructible_v<T>};
+
+    /// @typedef Type storing a `T`: `T` itself, or a pointer to its box.
+    template <typename T>
+    using Stored = std::conditional_t<isInPlace<T>, T, Box<T>*>;
+
+    /// @brief Storage of non-numeric values.
+    /// @details Its tag shares the first position with the representation
+    /// of `Num`, so it is valid whichever member of the storage union is
+    /// active: numbers are tagged by their representation. Copy-on-write
+    /// values only store pointers, keeping them to 16 bytes.
+    struct Storage
+    {
+        std::uint8_t tag;
+        union
+        {
+            Bln bln;
+            AlignedStorage<TCow ? sizeof(void*) : sizeof(Str), alignof(Str)>
+                data;
+        };
+    };
+
+    /// @brief Storage union for `Val` fundamental types.
+    union
+    {
+        Num num;
+        Storage storage{tagNll, {false}};
+    };
 
-    /// @brief Checked union storage for `Val` fundamental types.
-    Union<Obj, Arr, Str, Num, Bln> h;
+    inline bool isNumTag() const noexcept
+    {
+        return storage.tag < tagObj;
+    }
+
+    template <typename T>
+    inline auto& getStored() noexcept
+    {
+        return castStorage<Stored<T>>(storage.data);
+    }
+    template <typename T>
+    inline const auto& getStored() const noexcept
+    {
+        return castStorage<Stored<T>>(storage.data);
+    }
+
+    /// @brief Returns the address of the box of this value, or null if
+    /// it is not boxed.
+    inline const void* getBoxAddr() const noexcept
+    {
+        switch(storage.tag)
+        {
+            case tagObj: return getBoxAddrOf<Obj>();
+            case tagArr: return getBoxAddrOf<Arr>();
+            case tagStr: return getBoxAddrOf<Str>();
+            case tagNumArrIntS: return getBoxAddrOf<NumArr<IntS>>();
+            case tagNumArrReal: return getBoxAddrOf<NumArr<Real>>();
+            default: return nullptr;
+        }
+    }
+    template <typename T>
+    inline const void* getBoxAddrOf() const noexcept
+    {
+        if constexpr(isInPlace<T>)
+            return nullptr;
+        else
+            return getStored<T>();
+    }
+
+    template <typename T>
+    inline static bool isBoxShared(const Box<T>* mBox) noexcept
+    {
+        if constexpr(TCow)
+            return mBox->refs.load(std::memory_order_acquire) > 1;
+        else
+            return false;
+    }
+
+    /// @brief Returns a box holding a copy of the contents of `mBox`,
+    /// which is `mBox` itself if it can be shared.
+    template <typename T>
+    inline static Box<T>* copyBox(Box<T>* mBox)
+    {
+        if constexpr(TCow)
+            if(mBox->refs.load(std::memory_order_relaxed) != 0)
+            {
+                mBox->refs.fetch_add(1, std::memory_order_relaxed);
+                return mBox;
+            }
+
+        return new Box<T>(std::as_const(mBox->x));
+    }
+
+    /// @brief Releases this value's reference to `mBox`, deleting it if
+    /// it was the last one.
+    template <typename T>
+    inline static void releaseBox(Box<T>* mBox) noexcept
+    {
+        if constexpr(TCow)
+            if(mBox->refs.load(std::memory_order_acquire) != 0 &&
+                mBox->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+        delete mBox;
+    }
+
+    /// @brief Returns the contents of `mBox` for mutation, cloning it
+    /// first if it is shared.
+    template <typename T>
+    inline static T& ownBox(Box<T>*& mBox)
+    {
+        if constexpr(TCow)
+        {
+            const auto refs(mBox->refs.load(std::memory_order_acquire));
+            if(refs > 1)
+            {
+                auto clone(new Box<T>(std::as_const(mBox->x)));
+                releaseBox(mBox);
+                mBox = clone;
+            }
+
+            if(refs != 0) mBox->refs.store(0, std::memory_order_relaxed);
+        }
+
+        return mBox->x;
+    }
+
+    /// @brief Returns the contents of `mBox`, moved out if it is not
+    /// shared.
+    template <typename T>
+    inline static T takeBox(Box<T>* mBox)
+    {
+        if(isBoxShared(mBox)) return mBox->x;
+        return std::move(mBox->x);
+    }
+
+    /// @brief Constructs the stored `T` from `mArgs`, tagging it `mTag`.
+    /// @details The current storage must have been deinitialized.
+    template <typename T, typename... TArgs>
+    inline void initStored(std::uint8_t mTag, TArgs&&... mArgs)
+    {
+        if constexpr(isInPlace<T>)
+            new(&storage.data) T(FWD(mArgs)...);
+        else
+            new(&storage.data) Box<T>*(new Box<T>(FWD(mArgs)...));
+
+        storage.tag = mTag;
+    }
+
+    /// @brief Destroys the stored `T`, or releases its box.
+    template <typename T>
+    inline void deinitStored() noexcept
+    {
+        if constexpr(isInPlace<T>)
+            getStored<T>().~T();
+        else
+            releaseBox(getStored<T>());
+    }
+
+    /// @brief Stores a copy of the `T` stored by `mV`.
+    template <typename T>
+    inline void copyStored(const ValImpl& mV)
+    {
+        if constexpr(isInPlace<T>)
+            new(&storage.data) T(mV.getStored<T>());
+        else
+            new(&storage.data) Box<T>*(copyBox(mV.getStored<T>()));
+    }
+
+    /// @brief Steals the `T` stored by `mV`, whose storage is left
+    /// deinitialized.
+    template <typename T>
+    inline void moveStored(ValImpl& mV) noexcept
+    {
+        if constexpr(isInPlace<T>)
+        {
+            new(&storage.data) T(std::move(mV.getStored<T>()));
+            mV.getStored<T>().~T();
+        }
+        else
+            new(&storage.data) Box<T>*(mV.getStored<T>());
+    }
+
+    /// @brief Returns the stored `T` for reading.
+    template <typename T>
+    inline const T& readStored() const noexcept
+    {
+        if constexpr(isInPlace<T>)
+            return getStored<T>();
+        else
+            return getStored<T>()->x;
+    }
+
+    /// @brief Returns the stored `T` for mutation, cloning its box first
+    /// if it is shared.
+    template <typename T>
+    inline T& ownStored()
+    {
+        if constexpr(isInPlace<T>)
+            return getStored<T>();
+        else
+            return ownBox(getStored<T>());
+    }
+
+    /// @brief Returns the stored `T`, moved out if it is not shared.
+    template <typename T>
+    inline T takeStored()
+    {
+        if constexpr(isInPlace<T>)
+            return std::move(getStored<T>());
+        else
+            return takeBox(getStored<T>());
+    }
+
+    template <typename T>
+    inline bool isStoredShared() const noexcept
+    {
+        if constexpr(isInPlace<T>)
+            return false;
+        else
+            return isBoxShared(getStored<T>());
+    }
+
+    template <typename T>
+    inline static constexpr auto getNumArrTag() noexcept
+    {
+        static_assert(std::is_same_v<T, IntS> || std::is_same_v<T, Real>,
+            "Numeric arrays store either `IntS` or `Real` items");
+
+        return std::is_same_v<T, IntS> ? tagNumArrIntS : tagNumArrReal;
+    }
+
+    /// @brief Returns a regular `Arr` holding the items of the stored
+    /// numeric array.
+    template <typename T>
+    inline Arr unpackStored()
+    {
+        // The cached `Arr` of shared boxes may be in use
+        if(isStoredShared<NumArr<T>>())
+        {
+            const auto& items(readStored<NumArr<T>>().items);
+            return Arr(std::begin(items), std::end(items));
+        }
+
+        return ownStored<NumArr<T>>().toArr();
+    }
+
+    /// @brief Turns a numeric array into a regular `Arr`.
+    inline void unpackNumArr()
+    {
+        auto arr(storage.tag == tagNumArrIntS ? unpackStored<IntS>()
+                                              : unpackStored<Real>());
+        deinitCurrent();
+        setArr(std::move(arr));
+    }
+
+    /// @brief Stores the `mIdx`-th item of this array in `mOut`, returning
+    /// false if it is not a number.
+    /// @details Numeric arrays are read without being unpacked.
+    inline bool getArrItemNum(Idx mIdx, Num& mOut) const noexcept
+    {
+        if(storage.tag == tagNumArrIntS)
+            mOut = Num{getNumArr<IntS>()[mIdx]};
+        else if(storage.tag == tagNumArrReal)
+            mOut = Num{getNumArr<Real>()[mIdx]};
+        else if(readStored<Arr>()[mIdx].isNumTag())
+            mOut = readStored<Arr>()[mIdx].getNum();
+        else
+            return false;
+
+        return true;
+    }
+
+    /// @brief Returns true if this array and `mV` hold equal numbers.
+    /// @details Used when at least one of them is a numeric array, so that
+    /// neither is unpacked.
+    inline bool isArrEqualByNum(const ValImpl& mV) const noexcept
+    {
+        const auto size(getSizeArr());
+        if(size != mV.getSizeArr()) return false;
+
+        Num lhs, rhs;
+        for(Idx i{0}; i < size; ++i)
+            if(!getArrItemNum(i, lhs) || !mV.getArrItemNum(i, rhs) ||
+                lhs != rhs)
+                return false;
+
+        return true;
+    }
 
     // Perfect-forwarding setters
     template <typename T>
-    inline void setObj(T&& mX) noexcept(noexcept(Obj{FWD(mX)}))
+    inline void setObj(T&& mX)
     {
-        type = Type::TObj;
-        h.init<Obj>(FWD(mX));
+        initStored<Obj>(tagObj, FWD(mX));
     }
     template <typename T>
-    inline void setArr(T&& mX) noexcept(noexcept(Arr{FWD(mX)}))
+    inline void setArr(T&& mX)
     {
-        type = Type::TArr;
-        h.init<Arr>(FWD(mX));
+        initStored<Arr>(tagArr, FWD(mX));
     }
     template <typename T>
-    inline void setStr(T&& mX) noexcept(noexcept(Str{FWD(mX)}))
+    inline void setStr(T&& mX)
     {
-        type = Type::TStr;
-        h.init<Str>(FWD(mX));
+        initStored<Str>(tagStr, FWD(mX));
     }
     template <typename T>
     inline void setNum(T&& mX) noexcept(noexcept(Num{FWD(mX)}))
     {
-        type = Type::TNum;
-        h.init<Num>(FWD(mX));
+        num = Num{FWD(mX)};
     }
 
     // Basic setters
     inline void setBln(Bln mX) noexcept
     {
-        type = Type::TBln;
-        h.init<Bln>(mX);
+        storage.bln = mX;
+        storage.tag = tagBln;
     }
     inline void setNll(Nll) noexcept
     {
-        type = Type::TNll;
+        storage.tag = tagNll;
     }
 
-// Ref-qualified getters
-#define SSVJ_DEFINE_VAL_GETTER(mType, mMember)                   \
-    inline mType& VRM_PP_CAT(get, mType)()& noexcept             \
+// Ref-qualified getters of stored values
+#define SSVJ_DEFINE_VAL_GETTER(mType)                            \
+    inline mType& VRM_PP_CAT(get, mType)()&                      \
     {                                                            \
-        assert(is<mType>());                                \
-        return mMember;                                          \
+        assert(is<mType>());                                     \
+        return ownStored<mType>();                               \
     }                                                            \
     inline const mType& VRM_PP_CAT(get, mType)() const& noexcept \
     {                                                            \
-        assert(is<mType>());                                \
-        return mMember;                                          \
+        assert(is<mType>());                                     \
+        return readStored<mType>();                              \
     }                                                            \
-    inline mType VRM_PP_CAT(get, mType)()&& noexcept             \
+    inline mType VRM_PP_CAT(get, mType)()&&                      \
     {                                                            \
-        assert(is<mType>());                                \
-        return std::move(mMember);                               \
+        assert(is<mType>());                                     \
+        return takeStored<mType>();                              \
     }
 
-    SSVJ_DEFINE_VAL_GETTER(Obj, h.get<Obj>())
-    SSVJ_DEFINE_VAL_GETTER(Arr, h.get<Arr>())
-    SSVJ_DEFINE_VAL_GETTER(Str, h.get<Str>())
-    SSVJ_DEFINE_VAL_GETTER(Num, h.get<Num>())
+    SSVJ_DEFINE_VAL_GETTER(Obj)
+    SSVJ_DEFINE_VAL_GETTER(Str)
 
 #undef SSVJ_DEFINE_VAL_GETTER
 
+    inline Arr& getArr() &
+    {
+        assert(is<Arr>());
+        if(SSVU_UNLIKELY(storage.tag != tagArr)) unpackNumArr();
+        return ownStored<Arr>();
+    }
+    inline const Arr& getArr() const&
+    {
+        assert(is<Arr>());
+        if(SSVU_LIKELY(storage.tag == tagArr)) return readStored<Arr>();
+
+        return storage.tag == tagNumArrIntS
+                   ? readStored<NumArr<IntS>>().getArr()
+                   : readStored<NumArr<Real>>().getArr();
+    }
+    inline Arr getArr() &&
+    {
+        assert(is<Arr>());
+        if(SSVU_UNLIKELY(storage.tag != tagArr)) unpackNumArr();
+        return takeStored<Arr>();
+    }
+
+    // Numbers are stored inline
+    inline Num& getNum() & noexcept
+    {
+        assert(is<Num>());
+        return num;
+    }
+    inline const Num& getNum() const& noexcept
+    {
+        assert(is<Num>());
+        return num;
+    }
+    inline Num getNum() && noexcept
+    {
+        assert(is<Num>());
+        return num;
+    }
+
     // Other getters
     inline auto getBln() const noexcept
     {
         assert(is<Bln>());
-        return h.get<Bln>();
+        return storage.bln;
     }
     inline auto getNll() const noexcept
     {
@@ -141,42 +585,62 @@ private:
         return Nll{};
     }
 
-    /// @brief Deinitializes the current storage, calling the
-    /// appropriate destructor.
-    inline void deinitCurrent()
+    /// @brief Deinitializes the current storage, freeing stored values.
+    /// @details Leaves the value null.
+    inline void deinitCurrent() noexcept
     {
-        switch(type)
+        switch(storage.tag)
         {
-            case Type::TObj: h.deinit<Obj>(); break;
-            case Type::TArr: h.deinit<Arr>(); break;
-            case Type::TStr: h.deinit<Str>(); break;
-            case Type::TNum: h.deinit<Num>(); break;
-            case Type::TBln: h.deinit<Bln>(); break;
-            case Type::TNll: break;
+            case tagObj: deinitStored<Obj>(); break;
+            case tagArr: deinitStored<Arr>(); break;
+            case tagStr: deinitStored<Str>(); break;
+            case tagNumArrIntS: deinitStored<NumArr<IntS>>(); break;
+            case tagNumArrReal: deinitStored<NumArr<Real>>(); break;
             default: break;
         }
+
+        storage.tag = tagNll;
     }
 
     /// @brief Initializes the current storage from `mV`, calling
     /// the appropriate setter function.
+    /// @details Values are stolen from rvalues, which are left null.
     template <typename T>
     inline void init(T&& mV)
     {
-        switch(mV.type)
+        if(mV.isNumTag())
+            num = mV.num;
+        else
         {
-            case Type::TObj:
-                setObj(moveIfRValue<decltype(mV)>(mV.getObj()));
-                break;
-            case Type::TArr:
-                setArr(moveIfRValue<decltype(mV)>(mV.getArr()));
-                break;
-            case Type::TStr:
-                setStr(moveIfRValue<decltype(mV)>(mV.getStr()));
-                break;
-            case Type::TNum: setNum(mV.getNum()); break;
-            case Type::TBln: setBln(mV.getBln()); break;
-            case Type::TNll: setNll({}); break;
+            const auto tag(mV.storage.tag);
+            if constexpr(!std::is_lvalue_reference_v<T>)
+                switch(tag)
+                {
+                    case tagObj: moveStored<Obj>(mV); break;
+                    case tagArr: moveStored<Arr>(mV); break;
+                    case tagStr: moveStored<Str>(mV); break;
+                    case tagNumArrIntS: moveStored<NumArr<IntS>>(mV); break;
+                    case tagNumArrReal: moveStored<NumArr<Real>>(mV); break;
+                    case tagBln: storage.bln = mV.storage.bln; break;
+                    default: break;
+                }
+            else
+                // Boxes are read directly, as copying must not mutate `mV`
+                switch(tag)
+                {
+                    case tagObj: copyStored<Obj>(mV); break;
+                    case tagArr: copyStored<Arr>(mV); break;
+                    case tagStr: copyStored<Str>(mV); break;
+                    case tagNumArrIntS: copyStored<NumArr<IntS>>(mV); break;
+                    case tagNumArrReal: copyStored<NumArr<Real>>(mV); break;
+                    case tagBln: storage.bln = mV.storage.bln; break;
+                    default: break;
+                }
+
+            storage.tag = tag;
         }
+
+        if constexpr(!std::is_lvalue_reference_v<T>) mV.storage.tag = tagNll;
     }
 
     /// @brief Checks the stored type. Doesn't check number
@@ -189,27 +653,27 @@ private:
     }
 
 public:
-    inline Val() = default;
+    inline ValImpl() = default;
 
     // Copy/move constructors
-    inline Val(const Val& mV)
+    inline ValImpl(const ValImpl& mV)
     {
         init(mV);
     }
-    inline Val(Val&& mV)
+    inline ValImpl(ValImpl&& mV) noexcept
     {
         init(std::move(mV));
     }
 
     /// @brief Constructs the `Val` from `mX`.
-    template <typename T, SSVU_ENABLEIF_RA_IS_NOT(T, Val)>
-    inline Val(T&& mX)
+    template <typename T, SSVU_ENABLEIF_RA_IS_NOT(T, ValImpl)>
+    inline ValImpl(T&& mX)
     {
         set(FWD(mX));
     }
 
     // Destructor must deinitalize
-    inline ~Val()
+    inline ~ValImpl()
     {
         deinitCurrent();
     }
@@ -219,11 +683,21 @@ public:
     template <typename T>
     inline void set(T&& mX) noexcept(noexcept(
         Impl::Cnv<std::remove_cv_t<std::remove_reference_t<T>>, void>::toVal(
-            std::declval<Val&>(), FWD(mX))))
+            std::declval<ValImpl&>(), FWD(mX))))
     {
-        deinitCurrent();
-        Impl::Cnv<std::remove_cv_t<std::remove_reference_t<T>>, void>::toVal(
-            *this, FWD(mX));
+        if constexpr(std::is_same_v<std::decay_t<T>, ValImpl>)
+        {
+            // `mX` may be owned by this value
+            ValImpl temp{FWD(mX)};
+            deinitCurrent();
+            init(std::move(temp));
+        }
+        else
+        {
+            deinitCurrent();
+            Impl::Cnv<std::remove_cv_t<std::remove_reference_t<T>>,
+                void>::toVal(*this, FWD(mX));
+        }
     }
 
     /// @brief Checks if the stored internal value is of type `T`.
@@ -256,12 +730,12 @@ public:
     auto as() && -> decltype(Impl::AsHelper<T>::as(*this));
 
     // "Implicit" `set` function done via `operator=` overloading
-    Val& operator=(const Val& mV) noexcept;
-    Val& operator=(Val&& mV) noexcept;
+    ValImpl& operator=(const ValImpl& mV) noexcept;
+    ValImpl& operator=(ValImpl&& mV) noexcept;
 
     template <typename T>
-    inline Val& operator=(T&& mX) noexcept(
-        noexcept(std::declval<Val&>().set(FWD(mX))))
+    inline ValImpl& operator=(T&& mX) noexcept(
+        noexcept(std::declval<ValImpl&>().set(FWD(mX))))
     {
         set(FWD(mX));
         return *this;
@@ -282,7 +756,7 @@ public:
     }
 
     // "Implicit" Val from Arr by Idx getters
-    inline auto& operator[](Idx mIdx) noexcept
+    inline auto& operator[](Idx mIdx)
     {
         return getArr()[mIdx];
     }
@@ -306,13 +780,17 @@ public:
     /// `Arr`.
     inline bool has(Idx mIdx) const noexcept
     {
-        return getArr().size() > mIdx;
+        return getSizeArr() > mIdx;
     }
 
     /// @brief Returns the current internal storage type.
     inline auto getType() const noexcept
     {
-        return type;
+        constexpr Type types[]{Type::TNum, Type::TNum, Type::TNum,
+            Type::TObj, Type::TArr, Type::TStr, Type::TBln, Type::TNll,
+            Type::TArr, Type::TArr};
+
+        return types[storage.tag];
     }
 
     /// @brief Returns the value with key `mKey` is existant,
@@ -322,7 +800,7 @@ public:
     template <typename T>
     inline decltype(auto) getIfHas(const Key& mKey, const T& mDef) const
     {
-        return has(mKey) ? operator[](mKey).as<T>() : mDef;
+        return has(mKey) ? operator[](mKey).template as<T>() : mDef;
     }
 
     /// @brief Returns the value with index `mIdx` is existant,
@@ -332,18 +810,41 @@ public:
     template <typename T>
     inline decltype(auto) getIfHas(Idx mIdx, const T& mDef) const
     {
-        return has(mIdx) ? operator[](mIdx).as<T>() : mDef;
+        return has(mIdx) ? operator[](mIdx).template as<T>() : mDef;
+    }
+
+    /// @brief Returns true if this `Val` instance and `mV` share their
+    /// storage, which implies that they are equal.
+    /// @details Copies of a value only share their storage if `TCow` is
+    /// true.
+    inline bool sharesStorageWith(const ValImpl& mV) const noexcept
+    {
+        const auto addr(getBoxAddr());
+        return this == &mV || (addr != nullptr && addr == mV.getBoxAddr());
     }
 
     // Equality/inequality
-    inline bool SSVU_ATTRIBUTE(pure) operator==(const Val& mV) const noexcept
+    inline bool SSVU_ATTRIBUTE(pure)
+        operator==(const ValImpl& mV) const noexcept
     {
-        if(type != mV.type) return false;
+        if(sharesStorageWith(mV)) return true;
+
+        const auto type(getType());
+        if(type != mV.getType()) return false;
 
         switch(type)
         {
             case Type::TObj: return getObj() == mV.getObj();
-            case Type::TArr: return getArr() == mV.getArr();
+            case Type::TArr:
+                if(storage.tag == tagArr && mV.storage.tag == tagArr)
+                    return getArr() == mV.getArr();
+
+                if(storage.tag == mV.storage.tag)
+                    return storage.tag == tagNumArrIntS
+                               ? getNumArr<IntS>() == mV.getNumArr<IntS>()
+                               : getNumArr<Real>() == mV.getNumArr<Real>();
+
+                return isArrEqualByNum(mV);
             case Type::TStr: return getStr() == mV.getStr();
             case Type::TNum: return getNum() == mV.getNum();
             case Type::TBln: return getBln() == mV.getBln();
@@ -351,7 +852,7 @@ public:
             default: SSVU_UNREACHABLE();
         }
     }
-    inline auto operator!=(const Val& mV) const noexcept
+    inline auto operator!=(const ValImpl& mV) const noexcept
     {
         return !(operator==(mV));
     }
@@ -360,18 +861,19 @@ public:
     template <typename TWS = WSPretty>
     void writeToStream(std::ostream&) const;
     template <typename TWS = WSPretty>
-    inline void writeToStr(std::string& mStr) const
-    {
-        std::ostringstream o;
-        writeToStream<TWS>(o);
-        mStr = o.str();
-    }
+    bool writeToCFile(std::FILE* mFile) const;
+    template <typename TWS = WSPretty>
+    bool writeToFd(int mFd) const;
     template <typename TWS = WSPretty>
-    inline void writeToFile(const ssvufs::Path& mPath) const
+    void writeToStr(std::string& mStr) const;
+    template <typename TWS = WSPretty>
+    inline bool writeToFile(const ssvufs::Path& mPath) const
     {
-        std::ofstream o{mPath};
-        writeToStream<TWS>(o);
-        o.close();
+        auto file(std::fopen(mPath.getCStr(), "wb"));
+        if(file == nullptr) return false;
+
+        const auto result(writeToCFile<TWS>(file));
+        return std::fclose(file) == 0 && result;
     }
     template <typename TWS = WSPretty>
     inline auto getWriteToStr() const
@@ -381,33 +883,67 @@ public:
         return result;
     }
 
+    // Binary IO writing implementations
+    void writeToBinStream(std::ostream& mStream) const;
+    void writeToBinStr(std::string& mStr) const;
+    bool writeToBinFile(const ssvufs::Path& mPath) const;
+    inline auto getWriteToBinStr() const
+    {
+        std::string result;
+        writeToBinStr(result);
+        return result;
+    }
+
     // IO reading implementations
     template <typename TRS = RSDefault, typename T>
     void readFromStr(T&& mStr);
     template <typename TRS = RSDefault>
     inline void readFromFile(const ssvufs::Path& mPath)
     {
-        readFromStr(mPath.getContentsAsStr());
+        // Reading straight from the mapped file avoids buffering it
+        const ssvufs::MappedFile file{mPath};
+        readFromStr<TRS>(file.getView());
     }
 
     // Construction from strings or files
-    template <typename T>
-    inline static Val fromStr(T&& mStr)
+    template <typename TRS = RSDefault, typename T>
+    inline static ValImpl fromStr(T&& mStr)
+    {
+        ValImpl result;
+        result.readFromStr<TRS>(FWD(mStr));
+        return result;
+    }
+    template <typename TRS = RSDefault>
+    inline static ValImpl fromFile(const ssvufs::Path& mPath)
+    {
+        ValImpl result;
+        result.readFromFile<TRS>(mPath);
+        return result;
+    }
+
+    // Binary IO reading implementations
+    void readFromBinStr(std::string_view mStr);
+    void readFromBinFile(const ssvufs::Path& mPath);
+
+    // Construction from binary strings or files
+    inline static ValImpl fromBinStr(std::string_view mStr)
     {
-        Val result;
-        result.readFromStr(FWD(mStr));
+        ValImpl result;
+        result.readFromBinStr(mStr);
         return result;
     }
-    inline static Val fromFile(const ssvufs::Path& mPath)
+    inline static ValImpl fromBinFile(const ssvufs::Path& mPath)
     {
-        Val result;
-        result.readFromFile(mPath);
+        ValImpl result;
+        result.readFromBinFile(mPath);
         return result;
     }
 
     // Unchecked casted iteration
+    // Mutable iteration clones the shared storage of copy-on-write values,
+    // so it may throw
     template <typename T>
-    inline auto forUncheckedObjAs() noexcept
+    inline auto forUncheckedObjAs()
     {
         return VIH::makeItrObjRange<T>(
             std::begin(getObj()), std::end(getObj()));
@@ -418,14 +954,16 @@ public:
         return VIH::makeItrObjRange<T>(
             std::cbegin(getObj()), std::cend(getObj()));
     }
+    // Numeric arrays are unpacked by mutable iteration, and their items
+    // are converted once by const iteration: array iteration may throw
     template <typename T>
-    inline auto forUncheckedArrAs() noexcept
+    inline auto forUncheckedArrAs()
     {
         return VIH::makeItrArrRange<T>(
             std::begin(getArr()), std::end(getArr()));
     }
     template <typename T>
-    inline auto forUncheckedArrAs() const noexcept
+    inline auto forUncheckedArrAs() const
     {
         return VIH::makeItrArrRange<T>(
             std::cbegin(getArr()), std::cend(getArr()));
@@ -434,49 +972,41 @@ public:
     // Checked casted iteration
     // TODO: when is this needed?
     template <typename T>
-    inline auto forObjAs() noexcept
+    inline auto forObjAs()
     {
-        return is<Obj>()
-                   ? forUncheckedObjAs<T>()
-                   : VIH::makeItrObjRange<T>(std::begin(VIH::getEmptyObj()),
-                         std::end(VIH::getEmptyObj()));
+        auto& obj(is<Obj>() ? getObj() : VIH::getEmpty<Obj>());
+        return VIH::makeItrObjRange<T>(std::begin(obj), std::end(obj));
     }
     template <typename T>
     inline auto forObjAs() const noexcept
     {
-        return is<Obj>()
-                   ? forUncheckedObjAs<T>()
-                   : VIH::makeItrObjRange<T>(std::cbegin(VIH::getEmptyObj()),
-                         std::cend(VIH::getEmptyObj()));
+        const auto& obj(is<Obj>() ? getObj() : VIH::getEmpty<Obj>());
+        return VIH::makeItrObjRange<T>(std::cbegin(obj), std::cend(obj));
     }
     template <typename T>
-    inline auto forArrAs() noexcept
+    inline auto forArrAs()
     {
-        return is<Arr>()
-                   ? forUncheckedArrAs<T>()
-                   : VIH::makeItrArrRange<T>(std::begin(VIH::getEmptyArr()),
-                         std::end(VIH::getEmptyArr()));
+        auto& arr(is<Arr>() ? getArr() : VIH::getEmpty<Arr>());
+        return VIH::makeItrArrRange<T>(std::begin(arr), std::end(arr));
     }
     template <typename T>
-    inline auto forArrAs() const noexcept
+    inline auto forArrAs() const
     {
-        return is<Arr>()
-                   ? forUncheckedArrAs<T>()
-                   : VIH::makeItrArrRange<T>(std::cbegin(VIH::getEmptyArr()),
-                         std::cend(VIH::getEmptyArr()));
+        const auto& arr(is<Arr>() ? getArr() : VIH::getEmpty<Arr>());
+        return VIH::makeItrArrRange<T>(std::cbegin(arr), std::cend(arr));
     }
 
     // Unchecked non-casted iteration
-    auto forUncheckedObj() noexcept;
+    auto forUncheckedObj();
     auto forUncheckedObj() const noexcept;
-    auto forUncheckedArr() noexcept;
-    auto forUncheckedArr() const noexcept;
+    auto forUncheckedArr();
+    auto forUncheckedArr() const;
 
     // Checked non-casted iteration
-    auto forObj() noexcept;
+    auto forObj();
     auto forObj() const noexcept;
-    auto forArr() noexcept;
-    auto forArr() const noexcept;
+    auto forArr();
+    auto forArr() const;
 
     /// @brief Emplaces a value back into this `Val` instance's
     /// `Arr`.
@@ -489,10 +1019,63 @@ public:
         getArr().emplace_back(FWD(mX));
     }
 
+    /// @brief Returns true if this `Val` instance stores an `Arr` as a
+    /// contiguous array of `T`, which is either `IntS` or `Real`.
+    /// @details Arrays of at least `numArrThreshold` numbers, all read as
+    /// `IntS` or all read as `Real`, are stored this way by readers whose
+    /// settings enable `numArrs`. Accessing them as an `Arr` through a
+    /// const `Val` builds a regular copy once.
+    template <typename T>
+    inline bool isNumArr() const noexcept
+    {
+        return storage.tag == getNumArrTag<T>();
+    }
+
+    /// @brief Returns the contiguous items of this `Val` instance's
+    /// `Arr`, without copying them.
+    /// @details Must only be called on `Val` instances for which
+    /// `isNumArr<T>()` is true.
+    template <typename T>
+    inline const std::vector<T>& getNumArr() const noexcept
+    {
+        assert(isNumArr<T>());
+        return readStored<NumArr<T>>().items;
+    }
+
+    /// @brief Calls `mF` with the contiguous items of this `Val`
+    /// instance's `Arr`, if it is stored as a numeric array. Returns
+    /// true if `mF` was called.
+    template <typename TF>
+    inline bool visitNumArr(TF&& mF) const
+    {
+        if(isNumArr<IntS>())
+            mF(getNumArr<IntS>());
+        else if(isNumArr<Real>())
+            mF(getNumArr<Real>());
+        else
+            return false;
+
+        return true;
+    }
+
+    /// @brief Sets the `Val`'s internal value to an `Arr` storing the
+    /// numbers in `mItems` contiguously.
+    template <typename T>
+    inline void setNumArr(std::vector<T> mItems)
+    {
+        deinitCurrent();
+        initStored<NumArr<T>>(getNumArrTag<T>(), std::move(mItems));
+    }
+
     // Size getters
-    inline auto getSizeArr() const noexcept
+    inline std::size_t getSizeArr() const noexcept
     {
-        return getArr().size();
+        switch(storage.tag)
+        {
+            case tagNumArrIntS: return getNumArr<IntS>().size();
+            case tagNumArrReal: return getNumArr<Real>().size();
+            default: return getArr().size();
+        }
     }
     inline auto getSizeObj() const noexcept
     {
@@ -510,6 +1093,26 @@ public:
     }
 };
 
+/// @brief Forwards `mV` to a conversion: rvalues are moved from, lvalues
+/// are only read through a const reference.
+template <typename T>
+inline constexpr decltype(auto) fwdCnvSrc(T&& mV) noexcept
+{
+    if constexpr(std::is_lvalue_reference_v<T>)
+        return std::as_const(mV);
+    else
+        return std::move(mV);
+}
+
+/// @typedef JSON value with objects sorted by key.
+using Val = ValImpl<false, false>;
+
+/// @typedef JSON value with objects in insertion order, indexed by hash.
+using HashedVal = ValImpl<true, false>;
+
+/// @typedef JSON value sharing its storage with its copies.
+using CowVal = ValImpl<false, true>;
+
 /// @typedef `Obj` implementation typedef, templatized with `Val`.
 using Obj = Val::Obj;
 
@@ -518,8 +1121,25 @@ using Arr = Val::Arr;
 } // namespace Impl
 
 /// @typedef `Val` - json value.
+/// @details Stores its objects, arrays and strings in place, so reading a
+/// value only allocates their contents. `CowVal` is the compact 16-byte
+/// value.
 using Val = Impl::Val;
 
+/// @typedef `HashedVal` - json value whose objects keep their keys in
+/// insertion order, with a hash index for wide objects.
+/// @details Faster than `Val` to read and query when objects have many
+/// keys. Writing a value keeps the order of its keys.
+using HashedVal = Impl::HashedVal;
+
+/// @typedef `CowVal` - json value whose copies share its objects, arrays
+/// and strings until they are mutated.
+/// @details Copying a value is O(1). Mutable accesses (`operator[]`,
+/// `as<Arr>()`, `set`, ...) clone the shared storage along the accessed
+/// path, one level at a time. Reads never clone anything. Values take 16
+/// bytes, as objects, arrays and strings are stored in shared boxes.
+using CowVal = Impl::CowVal;
+
 /// @brief Returns a JSON value containing a JSON object filled with the
 /// passed key-value pairs.
 template <typename... TArgs>
@@ -543,16 +1163,17 @@ inline auto mkArr(TArgs&&... mArgs)
 }
 
 /// @brief Returns a JSON value constructed from the string `mStr`.
-template <typename T>
+template <typename TRS = RSDefault, typename T>
 inline auto fromStr(T&& mStr)
 {
-    return Val::fromStr(FWD(mStr));
+    return Val::fromStr<TRS>(FWD(mStr));
 }
 
 /// @brief Returns a JSON value constructed from the file in `mPath`.
+template <typename TRS = RSDefault>
 inline auto fromFile(const ssvufs::Path& mPath)
 {
-    return Val::fromFile(mPath);
+    return Val::fromFile<TRS>(mPath);
 }
 } // namespace Json
 } // namespace ssvu
@@ -19,83 +19,129 @@ namespace ssvu
 {
 namespace Json
 {
-inline Val& Val::operator=(const Val& mV) noexcept
+namespace Impl
+{
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::operator=(const ValImpl& mV) noexcept
+    -> ValImpl&
 {
     set(mV);
     return *this;
 }
-inline Val& Val::operator=(Val&& mV) noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::operator=(ValImpl&& mV) noexcept
+    -> ValImpl&
 {
     set(std::move(mV));
     return *this;
 }
 
+template <bool THashedObj, bool TCow>
 template <typename T>
-inline auto Val::as() & -> decltype(Impl::AsHelper<T>::as(*this))
+inline auto ValImpl<THashedObj, TCow>::as() & -> decltype(
+    Impl::AsHelper<T>::as(*this))
 {
     assert(isNoNum<T>());
     return Impl::AsHelper<T>::as(*this);
 }
+template <bool THashedObj, bool TCow>
 template <typename T>
-inline auto Val::as() const& -> decltype(Impl::AsHelper<T>::as(*this))
+inline auto ValImpl<THashedObj, TCow>::as() const& -> decltype(
+    Impl::AsHelper<T>::as(*this))
 {
     assert(isNoNum<T>());
     return Impl::AsHelper<T>::as(*this);
 }
+template <bool THashedObj, bool TCow>
 template <typename T>
-inline auto Val::as() && -> decltype(Impl::AsHelper<T>::as(*this))
+inline auto ValImpl<THashedObj, TCow>::as() && -> decltype(
+    Impl::AsHelper<T>::as(*this))
 {
     assert(isNoNum<T>());
     return std::move(Impl::AsHelper<T>::as(*this));
 }
 
+template <bool THashedObj, bool TCow>
 template <typename TWS>
-inline void Val::writeToStream(std::ostream& mStream) const
+inline void ValImpl<THashedObj, TCow>::writeToStream(
+    std::ostream& mStream) const
 {
-    Impl::Writer<TWS> w;
-    w.write(*this, mStream);
+    StreamSink s{{&mStream}};
+    writeToSink<TWS>(*this, s);
     mStream.flush();
 }
+template <bool THashedObj, bool TCow>
+template <typename TWS>
+inline bool ValImpl<THashedObj, TCow>::writeToCFile(std::FILE* mFile) const
+{
+    CFileSink s{{mFile}};
+    return writeToSink<TWS>(*this, s);
+}
+template <bool THashedObj, bool TCow>
+template <typename TWS>
+inline bool ValImpl<THashedObj, TCow>::writeToFd(int mFd) const
+{
+    FdSink s{{mFd}};
+    return writeToSink<TWS>(*this, s);
+}
+template <bool THashedObj, bool TCow>
+template <typename TWS>
+inline void ValImpl<THashedObj, TCow>::writeToStr(std::string& mStr) const
+{
+    mStr.clear();
+    StrSink s{mStr};
+    writeToSink<TWS>(*this, s);
+}
+template <bool THashedObj, bool TCow>
 template <typename TRS, typename T>
-inline void Val::readFromStr(T&& mStr)
+inline void ValImpl<THashedObj, TCow>::readFromStr(T&& mStr)
 {
-    Impl::Reader<TRS> r{FWD(mStr)};
-    Impl::tryParse<TRS>(*this, r);
+    Reader<TRS> r{FWD(mStr)};
+    tryParse<TRS>(*this, r);
 }
 
-inline auto Val::forUncheckedObj() noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forUncheckedObj()
 {
-    return forUncheckedObjAs<Val>();
+    return forUncheckedObjAs<ValImpl>();
 }
-inline auto Val::forUncheckedObj() const noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forUncheckedObj() const noexcept
 {
-    return forUncheckedObjAs<Val>();
+    return forUncheckedObjAs<ValImpl>();
 }
-inline auto Val::forUncheckedArr() noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forUncheckedArr()
 {
-    return forUncheckedArrAs<Val>();
+    return forUncheckedArrAs<ValImpl>();
 }
-inline auto Val::forUncheckedArr() const noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forUncheckedArr() const
 {
-    return forUncheckedArrAs<Val>();
+    return forUncheckedArrAs<ValImpl>();
 }
 
-inline auto Val::forObj() noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forObj()
 {
-    return forObjAs<Val>();
+    return forObjAs<ValImpl>();
 }
-inline auto Val::forObj() const noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forObj() const noexcept
 {
-    return forObjAs<Val>();
+    return forObjAs<ValImpl>();
 }
-inline auto Val::forArr() noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forArr()
 {
-    return forArrAs<Val>();
+    return forArrAs<ValImpl>();
 }
-inline auto Val::forArr() const noexcept
+template <bool THashedObj, bool TCow>
+inline auto ValImpl<THashedObj, TCow>::forArr() const
 {
-    return forArrAs<Val>();
+    return forArrAs<ValImpl>();
 }
+} // namespace Impl
 } // namespace Json
 } // namespace ssvu
 
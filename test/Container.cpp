@@ -52,6 +52,9 @@ int main()
 
         tm2[0] = 5;
         TEST_ASSERT(tm2[0] == 5 && tm2.at(0) == 5);
+
+        TEST_ASSERT(tm2.erase(1) == 1 && tm2.erase(1) == 0);
+        TEST_ASSERT(tm2.size() == 2 && !tm2.has(1) && tm2.at(2) == 4);
     }
     {
         using namespace ssvu;
@@ -120,4 +123,84 @@ int main()
             TEST_ASSERT(vs.size() == 0);
         }
     }
+    {
+        using namespace ssvu;
+
+        VecHashMap<std::string, int> tm;
+
+        TEST_ASSERT(tm.empty());
+        TEST_ASSERT(tm.size() == 0);
+
+        // Items keep their insertion order, below and past the hash index
+        // threshold
+        std::vector<std::string> words;
+        for(auto i(0); i < 1000; ++i)
+        {
+            words.emplace_back(toStr((i * 7919) % 1000));
+            tm[words.back()] = i;
+
+            TEST_ASSERT(tm.size() == words.size());
+            TEST_ASSERT(tm.has(words.back()) && !tm.has("x"));
+        }
+
+        for(auto i(0u); i < words.size(); ++i)
+        {
+            TEST_ASSERT(tm.getData()[i].first == words[i]);
+            TEST_ASSERT(tm[words[i]] == int(i) && tm.at(words[i]) == int(i));
+            TEST_ASSERT(tm.count(words[i]) == 1);
+        }
+
+        TEST_ASSERT(tm.atOrDefault("banana") == 0);
+        TEST_ASSERT(tm.atItr("banana") == std::end(tm.getData()));
+        TEST_ASSERT(tm.atItr("5")->second == tm["5"]);
+
+        tm["5"] = -1;
+        TEST_ASSERT(tm.size() == 1000 && tm.at("5") == -1);
+
+        bool thrown{false};
+        try
+        {
+            tm.at("banana");
+        }
+        catch(const std::out_of_range&)
+        {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown);
+
+        // Equality does not depend on insertion order
+        VecHashMap<std::string, int> rev;
+        rev.reserve(tm.size());
+        for(auto itr(tm.rbegin()); itr != tm.rend(); ++itr)
+            rev[itr->first] = itr->second;
+
+        TEST_ASSERT(rev == tm);
+        rev["5"] = 5;
+        TEST_ASSERT(rev != tm);
+
+        VecHashMap<int, int> small{{2, 4}, {0, 0}, {1, 2}};
+        TEST_ASSERT((small == VecHashMap<int, int>{{0, 0}, {1, 2}, {2, 4}}));
+        TEST_ASSERT(small.getData()[0].first == 2);
+
+        auto moved(std::move(tm));
+        TEST_ASSERT(moved.size() == 1000 && moved.at("5") == -1);
+
+        moved.clear();
+        TEST_ASSERT(moved.empty() && !moved.has("5"));
+        moved["a"] = 1;
+        TEST_ASSERT(moved.size() == 1 && moved.at("a") == 1);
+
+        // Erasing preserves the order of the other items, with and
+        // without the hash index
+        for(auto count : {5, 100})
+        {
+            VecHashMap<int, int> er;
+            for(auto i(0); i < count; ++i) er[i] = i * 2;
+
+            TEST_ASSERT(er.erase(3) == 1 && er.erase(3) == 0);
+            TEST_ASSERT(er.size() == std::size_t(count - 1) && !er.has(3));
+            TEST_ASSERT(er.getData()[3].first == 4 && er.at(4) == 8);
+            TEST_ASSERT(er.at(count - 1) == (count - 1) * 2);
+        }
+    }
 }
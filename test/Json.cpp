@@ -6,10 +6,21 @@
 #include "SSVUtils/Json/Json.hpp"
 #include "./utils/test_utils.hpp"
 
+#include <atomic>
 #include <bitset>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <cstdio>
 #include <string>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 using namespace std::literals;
 
 SSVJ_CNV_NAMESPACE()
@@ -42,6 +53,98 @@ SSVJ_CNV_NAMESPACE()
 }
 SSVJ_CNV_NAMESPACE_END()
 
+namespace
+{
+// Counts reading events and sums all numbers
+struct TestSaxCounter : ssvu::Json::SaxHandler
+{
+    int depth{0}, maxDepth{0}, keys{0}, strs{0}, blns{0}, nlls{0};
+    double sum{0.0};
+    std::string keyCat;
+
+    void onObjBegin()
+    {
+        maxDepth = std::max(maxDepth, ++depth);
+    }
+    void onObjEnd()
+    {
+        --depth;
+    }
+    void onArrBegin()
+    {
+        maxDepth = std::max(maxDepth, ++depth);
+    }
+    void onArrEnd()
+    {
+        --depth;
+    }
+    void onKey(std::string_view mKey)
+    {
+        ++keys;
+        keyCat += mKey;
+    }
+    void onStr(std::string_view)
+    {
+        ++strs;
+    }
+    void onNum(const ssvu::Json::Impl::Num& mNum)
+    {
+        sum += mNum.as<ssvu::Json::Real>();
+    }
+    void onBln(bool)
+    {
+        ++blns;
+    }
+    void onNll()
+    {
+        ++nlls;
+    }
+};
+
+// Types read through streamable converters
+struct TestCnvWindow
+{
+    std::string title;
+    int width{0}, height{0};
+    bool fullscreen{false};
+};
+
+struct TestCnvConfig
+{
+    TestCnvWindow window;
+    std::vector<TestCnvWindow> others;
+    std::vector<int> ids;
+    float scale{1.f};
+    std::pair<int, int> pos{0, 0};
+};
+
+// Number of dynamic allocations made so far
+std::atomic<std::size_t> allocCount{0};
+} // namespace
+
+void* operator new(std::size_t mSize)
+{
+    ++allocCount;
+    if(auto p = std::malloc(mSize == 0 ? 1 : mSize)) return p;
+    throw std::bad_alloc{};
+}
+void* operator new(std::size_t mSize, const std::nothrow_t&) noexcept
+{
+    ++allocCount;
+    return std::malloc(mSize == 0 ? 1 : mSize);
+}
+void operator delete(void* mPtr) noexcept
+{
+    std::free(mPtr);
+}
+void operator delete(void* mPtr, std::size_t) noexcept
+{
+    std::free(mPtr);
+}
+
+SSVJ_CNV_OBJ_AUTO(TestCnvWindow, title, width, height, fullscreen)
+SSVJ_CNV_OBJ_AUTO(TestCnvConfig, window, others, ids, scale, pos)
+
 int main()
 {
 
@@ -692,4 +795,1561 @@ int main()
             TEST_ASSERT_NS_OP(v.is<Bts>(), ==, true);
         }
     }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        // In-situ parsing must match the two-pass parser
+        std::string src{R"(
+            // Comment before the root
+            {
+                "a" : [ 1, 2 , 3.5 ], // trailing comment
+                "b" :
+                {
+                    "c // not a comment" : "x\"y",
+                    "d": [ ]
+                },
+                "e" : true, "f" : null
+            }
+        )"};
+
+        auto v0(fromStr(src));
+        auto v1(fromStr<RSInSitu>(src));
+        TEST_ASSERT_NS(v0 == v1);
+        TEST_ASSERT_NS(v1["a"][2].as<Real>() == 3.5);
+        TEST_ASSERT_NS(v1["b"]["c // not a comment"].as<Str>() == "x\"y");
+        TEST_ASSERT_NS(v1["b"]["d"].isEmptyArr());
+
+        // The source does not need to be null-terminated
+        std::string_view view{"[10, 20]30", 8};
+        auto v2(fromStr<RSInSitu>(view));
+        TEST_ASSERT_NS(v2.getSizeArr() == 2);
+        TEST_ASSERT_NS(v2[1].as<int>() == 20);
+
+        // Indexed parsing falls back to in-situ parsing with comments
+        TEST_ASSERT_NS(fromStr<RSIndexed>(src) == v0);
+    }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        // Indexed parsing must handle escapes and strings crossing the
+        // 64-byte block boundaries
+        const std::string body{R"({ "k\\" : [ "a\"b\\", -1.5e2 , true, )"
+                               R"("\\\\\"", { "x":null, "y" :"]}\\" } ] })"};
+
+        for(auto i(0u); i < 130; ++i)
+        {
+            auto src(std::string(i, ' ') + body);
+            auto v0(fromStr(src));
+            auto v1(fromStr<RSIndexed>(src));
+
+            TEST_ASSERT_NS(v0 == v1);
+            TEST_ASSERT_NS(v1["k\\"][0].as<Str>() == "a\"b\\");
+            TEST_ASSERT_NS(v1["k\\"][1].as<Real>() == -150.0);
+            TEST_ASSERT_NS(v1["k\\"][3].as<Str>() == "\\\\\"");
+            TEST_ASSERT_NS(v1["k\\"][4]["y"].as<Str>() == "]}\\");
+        }
+    }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Indexed parsing must handle sources spanning many index windows,
+        // falling back to in-situ parsing from a window with comments
+        std::string src{"[\n"};
+        for(auto i(0u); i < 3000; ++i)
+            src += R"(  { "id" : )" + toStr(i) + R"(, "text" : ")" +
+                   std::string(i % 97, 'a' + i % 26) +
+                   R"(\"", "ok" : true },)" + "\n";
+
+        auto withComment(src + "  // comment\n  null\n]");
+        src += "  null\n]";
+
+        for(const auto& s : {src, withComment})
+        {
+            auto v0(fromStr<RSInSitu>(s));
+            auto v1(fromStr<RSIndexed>(s));
+
+            TEST_ASSERT_NS(v0 == v1);
+            TEST_ASSERT_NS(v1.getSizeArr() == 3001);
+            TEST_ASSERT_NS(v1[2999]["text"].as<Str>().size() == 90);
+
+            TestSaxCounter c0, c1;
+            TEST_ASSERT_NS(saxFromStr<RSInSitu>(s, c0));
+            TEST_ASSERT_NS(saxFromStr<RSIndexed>(s, c1));
+            TEST_ASSERT_NS(c0.keyCat == c1.keyCat && c0.sum == c1.sum);
+            TEST_ASSERT_NS(c1.strs == 3000 && c1.nlls == 1);
+        }
+
+        auto accepts([](const std::string& mSrc) {
+            TestSaxCounter c;
+            return saxFromStr<RSIndexed>(mSrc, c);
+        });
+
+        const auto body(src.substr(0, src.size() - 8));
+        TEST_ASSERT_NS(accepts(body + "1]"));
+        TEST_ASSERT_NS(!accepts(body + "1x]"));
+        TEST_ASSERT_NS(!accepts(body + "truex]"));
+        TEST_ASSERT_NS(!accepts(body + "\"abc"));
+        TEST_ASSERT_NS(!accepts(body + "1"));
+    }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // SAX reading must report every value without building a tree
+        std::string src{R"({
+            "a" : [ 1, 2.5, -3 ], // comment
+            "b\\\"" : { "c" : "x\ty", "d" : [ true, false, null ] },
+            "e" : [ [ ], { } ]
+        })"};
+
+        TestSaxCounter c0, c1;
+        TEST_ASSERT_NS(saxFromStr(src, c0));
+        TEST_ASSERT_NS(saxFromStr<RSInSitu>(src, c1));
+
+        for(const auto& c : {c0, c1})
+        {
+            TEST_ASSERT_NS(c.depth == 0);
+            TEST_ASSERT_NS(c.maxDepth == 3);
+            TEST_ASSERT_NS(c.keys == 5);
+            TEST_ASSERT_NS(c.keyCat == "ab\\\"cde");
+            TEST_ASSERT_NS(c.strs == 1);
+            TEST_ASSERT_NS(c.blns == 2);
+            TEST_ASSERT_NS(c.nlls == 1);
+            TEST_ASSERT_NS(c.sum == 0.5);
+        }
+
+        // Malformed sources are reported as failures
+        TestSaxCounter c2;
+        TEST_ASSERT_NS(!saxFromStr(R"({ "a" : [ 1, 2 })", c2));
+    }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Chunked reading must match whole reading wherever the input is
+        // split, including inside strings, escapes, numbers and comments
+        const std::string src{R"({ "ab\"c" : [ 12345, -6.5e1, "x\\y" ], )"
+                              R"(// comment
+                              "d" : { "e" : true, "f" : null } })"};
+        const auto expected(fromStr(src));
+
+        for(auto i(0u); i <= src.size(); ++i)
+        {
+            std::vector<Val> vals;
+            auto onVal([&vals](Val&& mV) { vals.emplace_back(std::move(mV)); });
+
+            ChunkReader r;
+            r.feedVals(std::string_view{src}.substr(0, i), onVal);
+            r.feedVals(std::string_view{src}.substr(i), onVal);
+            r.finishVals(onVal);
+
+            TEST_ASSERT_NS(vals.size() == 1);
+            TEST_ASSERT_NS(vals[0] == expected);
+        }
+
+        // Newline-delimited values, fed one character at a time
+        const std::string stream{"1\n\"s\"\n[true]\n{\"k\":2.5}\n-3"};
+        std::vector<Val> vals;
+        ChunkReader r;
+
+        for(auto c : stream)
+            r.feedVals(std::string_view{&c, 1},
+                [&vals](Val&& mV) { vals.emplace_back(std::move(mV)); });
+
+        // The last number is only complete at the end of the input
+        TEST_ASSERT_NS(vals.size() == 4);
+        TEST_ASSERT_NS(!r.isIdle());
+        r.finishVals([&vals](Val&& mV) { vals.emplace_back(std::move(mV)); });
+        TEST_ASSERT_NS(r.isIdle());
+
+        TEST_ASSERT_NS(vals.size() == 5);
+        TEST_ASSERT_NS(vals[0].as<int>() == 1);
+        TEST_ASSERT_NS(vals[1].as<Str>() == "s");
+        TEST_ASSERT_NS(vals[2][0].as<bool>() == true);
+        TEST_ASSERT_NS(vals[3]["k"].as<Real>() == 2.5);
+        TEST_ASSERT_NS(vals[4].as<int>() == -3);
+
+        // SAX events can be received directly
+        TestSaxCounter c;
+        r.feed("[ \"a\", 1, 2, { \"k\" : nu", c);
+        r.feed("ll } ]", c);
+        r.finish(c);
+        TEST_ASSERT_NS(c.maxDepth == 2 && c.depth == 0);
+        TEST_ASSERT_NS(c.strs == 1 && c.keys == 1 && c.nlls == 1);
+        TEST_ASSERT_NS(c.sum == 3.0);
+
+        // Malformed and truncated inputs are reported
+        auto throws([](std::string_view mSrc) {
+            ChunkReader cr;
+            try
+            {
+                cr.feedVals(mSrc, [](Val&&) {});
+                cr.finishVals([](Val&&) {});
+            }
+            catch(const ReadException&)
+            {
+                return true;
+            }
+            return false;
+        });
+
+        TEST_ASSERT_NS(throws("[1, 2}"));
+        TEST_ASSERT_NS(throws("{\"a\" 1}"));
+        TEST_ASSERT_NS(throws("[tru]"));
+        TEST_ASSERT_NS(throws("[1, 2"));
+        TEST_ASSERT_NS(throws("\"abc"));
+        TEST_ASSERT_NS(throws("1.2.3"));
+        TEST_ASSERT_NS(!throws(" [ ] // trailing comment"));
+    }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // NDJSON writing and parallel reading must round-trip
+        std::vector<Val> records;
+        for(auto i(0u); i < 2000; ++i)
+            records.emplace_back(mkObj("id", i, "name", "r\n\"" + toStr(i),
+                "tags", mkArr(i % 2 == 0, Nll{}, i * 0.5)));
+
+        auto src(getWriteToStrNd(records));
+        TEST_ASSERT_NS(std::count(std::begin(src), std::end(src), '\n') ==
+                       2000);
+
+        TEST_ASSERT_NS(fromStrNd(src, 1) == records);
+        TEST_ASSERT_NS(fromStrNd(src, 4) == records);
+        TEST_ASSERT_NS(fromStrNd<RSDefault>(src, 3) == records);
+
+        // Blank lines are skipped
+        TEST_ASSERT_NS(fromStrNd("\n 1 \r\n\n[2]\n\n").size() == 2);
+
+        // Callbacks receive the record index, possibly concurrently
+        std::vector<int> ids(2000, -1);
+        TEST_ASSERT_NS(forRecordsNd(src,
+            [&ids](std::size_t mIdx, Val&& mV) {
+                ids[mIdx] = mV["id"].as<int>();
+            },
+            4));
+
+        for(auto i(0u); i < ids.size(); ++i) TEST_ASSERT_NS(ids[i] == int(i));
+
+        // Malformed records are reported and left null
+        auto bad(src + "{\"id\": }\n" + src);
+        TEST_ASSERT_NS(!forRecordsNd(bad, [](std::size_t, Val&&) {}, 4));
+
+        auto badRecords(fromStrNd(bad, 4));
+        TEST_ASSERT_NS(badRecords.size() == 4001);
+        TEST_ASSERT_NS(badRecords[2000].is<Nll>());
+        TEST_ASSERT_NS(badRecords[4000] == records[1999]);
+
+        // Lines containing more than one value are malformed
+        TEST_ASSERT_NS(!forRecordsNd(
+            "{\"a\":1}{\"b\":2}\n[3]", [](std::size_t, Val&&) {}, 1));
+
+        auto twoVals(fromStrNd("[1]\n{\"a\":1}{\"b\":2}\n[3] // c\n", 1));
+        TEST_ASSERT_NS(twoVals.size() == 3);
+        TEST_ASSERT_NS(twoVals[1].is<Nll>());
+        TEST_ASSERT_NS(twoVals[2][0].as<int>() == 3);
+    }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        // Numbers are stored exactly in the narrowest fitting representation
+        auto num([](const char* mSrc) {
+            auto v(fromStr(mSrc));
+            return v.as<Num>();
+        });
+
+        TEST_ASSERT_NS(num("0").getRepr() == Num::Repr::IntS);
+        TEST_ASSERT_NS(num("-42").as<IntS>() == -42);
+        TEST_ASSERT_NS(num("9223372036854775807").as<IntS>() ==
+                       std::numeric_limits<IntS>::max());
+        TEST_ASSERT_NS(num("-9223372036854775808").as<IntS>() ==
+                       std::numeric_limits<IntS>::min());
+
+        TEST_ASSERT_NS(
+            num("9223372036854775808").getRepr() == Num::Repr::IntU);
+        TEST_ASSERT_NS(num("18446744073709551615").as<IntU>() ==
+                       std::numeric_limits<IntU>::max());
+
+        TEST_ASSERT_NS(
+            num("18446744073709551616").getRepr() == Num::Repr::Real);
+        TEST_ASSERT_NS(num("18446744073709551616").as<Real>() == 0x1p64);
+        TEST_ASSERT_NS(num("-9223372036854775809").as<Real>() == -0x1p63);
+
+        TEST_ASSERT_NS(num("1.0").getRepr() == Num::Repr::Real);
+        TEST_ASSERT_NS(num("1e2").getRepr() == Num::Repr::Real);
+        TEST_ASSERT_NS(num("1E+2").as<Real>() == 100.0);
+
+        // Doubles are correctly rounded, including halfway and subnormal
+        // cases
+        TEST_ASSERT_NS(num("0.1").as<Real>() == 0.1);
+        TEST_ASSERT_NS(num("-2.5e-3").as<Real>() == -2.5e-3);
+        TEST_ASSERT_NS(num("9007199254740993").as<IntS>() == 9007199254740993);
+        TEST_ASSERT_NS(num("9007199254740993.0").as<Real>() == 0x1p53);
+        TEST_ASSERT_NS(
+            num("9007199254740993.000000000000000000001").as<Real>() ==
+            0x1p53 + 2);
+        TEST_ASSERT_NS(num("1.7976931348623157e308").as<Real>() ==
+                       std::numeric_limits<Real>::max());
+        TEST_ASSERT_NS(num("4.9406564584124654e-324").as<Real>() ==
+                       std::numeric_limits<Real>::denorm_min());
+        TEST_ASSERT_NS(num("2.2250738585072014e-308").as<Real>() ==
+                       std::numeric_limits<Real>::min());
+        TEST_ASSERT_NS(num("1e-400").as<Real>() == 0.0);
+        TEST_ASSERT_NS(num("1e400").as<Real>() ==
+                       std::numeric_limits<Real>::infinity());
+
+        // Invalid numbers are rejected
+        for(auto src :
+            {"[-]", "[1.]", "[.5]", "[1e]", "[1e+]", "[-.5]", "[01]"})
+        {
+            Val v;
+            Reader<> r{std::string{src}};
+            TEST_ASSERT_NS(!tryParse(v, r));
+        }
+    }
+
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        // Reals are written in their shortest form and read back exactly,
+        // keeping their representation
+        Val v{Arr{1.0, 0.1, -2.5e-7, 1e21, 5e-324, 100, -0.0}};
+        TEST_ASSERT_NS(v.getWriteToStr<WSMinified>() ==
+                       "[1.0,0.1,-2.5e-7,1e+21,5e-324,100,-0.0]");
+
+        auto vRead(fromStr(v.getWriteToStr<WSMinified>()));
+        TEST_ASSERT_NS(vRead[0].as<Num>().getRepr() ==
+                       Num::Repr::Real);
+        TEST_ASSERT_NS(vRead[5].as<Num>().getRepr() ==
+                       Num::Repr::IntS);
+
+        Arr reals;
+        for(auto i(0u); i < 1000; ++i)
+            reals.emplace_back(getRndR<Real>(-1.0, 1.0) *
+                               std::pow(10.0, getRndI<int, int>(-300, 300)));
+
+        auto realsRead(fromStr(Val{reals}.getWriteToStr<WSMinified>()));
+        for(auto i(0u); i < reals.size(); ++i)
+            TEST_ASSERT_NS(realsRead[i].as<Real>() == reals[i].as<Real>());
+
+        // Non-finite numbers cannot be represented and are written as null
+        TEST_ASSERT_NS(
+            Val{std::numeric_limits<Real>::infinity()}.getWriteToStr() ==
+            "null");
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Documents view the source and hold the same values as `Val`s
+        std::string src{R"({"a": [1, -2, 3.5, "x\ny"], "b\"k": {"c": true},
+            "d": null, "e": "plain", "f": [], "g": {}})"};
+
+        auto doc(Document::fromStr(std::string_view{src}));
+        TEST_ASSERT_NS(doc.toVal() == fromStr(src));
+        TEST_ASSERT_NS(doc.getRoot().getSizeObj() == 6);
+
+        auto a(doc["a"]);
+        TEST_ASSERT_NS(a.getSizeArr() == 4);
+        TEST_ASSERT_NS(a[0].is<IntS>() && a[0].as<int>() == 1);
+        TEST_ASSERT_NS(a[2].is<Real>() && a[2].as<Real>() == 3.5);
+        TEST_ASSERT_NS(a[3].as<std::string_view>() == "x\ny");
+        TEST_ASSERT_NS(a[3].as<Str>() == "x\ny");
+        TEST_ASSERT_NS(doc["b\"k"]["c"].as<Bln>());
+        TEST_ASSERT_NS(doc["d"].is<Nll>());
+        TEST_ASSERT_NS(doc["f"].isEmptyArr() && doc["g"].isEmptyObj());
+
+        // Plain strings point into the source
+        TEST_ASSERT_NS(doc["e"].as<std::string_view>().data() > src.data());
+        TEST_ASSERT_NS(doc["e"].as<std::string_view>().data() <
+                       src.data() + src.size());
+
+        // Missing keys and indices are null
+        TEST_ASSERT_NS(!doc.getRoot().has("z") && doc["z"].is<Nll>());
+        TEST_ASSERT_NS(!a.has(4) && a[4].is<Nll>());
+        TEST_ASSERT_NS(doc.getRoot().getIfHas<int>("z", 7) == 7);
+
+        std::string keys;
+        for(const auto& p : doc.getRoot().forObj()) keys += p.first;
+        TEST_ASSERT_NS(keys == "ab\"kdefg");
+
+        auto sum(0.0);
+        for(const auto& v : a.forArr())
+            if(v.getType() == Val::Type::TNum) sum += v.as<Real>();
+        TEST_ASSERT_NS(sum == 2.5);
+
+        // Rvalue sources are owned, and survive moving the document
+        auto owned(Document::fromStr(std::string{src}));
+        auto moved(std::move(owned));
+        TEST_ASSERT_NS(moved.toVal() == doc.toVal());
+        TEST_ASSERT_NS(moved["a"][3].as<Str>() == "x\ny");
+
+        // Reading errors leave a null document
+        Document bad;
+        TEST_ASSERT_NS(!bad.readFromStr(std::string_view{"[1, 2"}));
+        TEST_ASSERT_NS(bad.getType() == Val::Type::TNll);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        // Arena allocations are aligned and survive block growth
+        Arena arena;
+        std::vector<std::pair<IntS*, IntS>> allocs;
+        for(auto i(0); i < 2000; ++i)
+        {
+            arena.allocArr<char>(std::size_t(i % 7));
+            auto p(arena.allocArr<IntS>(std::size_t(i % 50 + 1)));
+            TEST_ASSERT_NS(reinterpret_cast<std::uintptr_t>(p) %
+                               alignof(IntS) ==
+                           0);
+            *p = i;
+            allocs.emplace_back(p, i);
+        }
+
+        auto moved(std::move(arena));
+        for(const auto& a : allocs) TEST_ASSERT_NS(*a.first == a.second);
+
+        // Large documents are indexed in constant time, and reading again
+        // reuses the arena
+        Val big{Arr{}};
+        for(auto i(0); i < 5000; ++i)
+            big.emplace(mkObj("i", i, "s", toStr(i), "a", mkArr(i, i + 1)));
+
+        Document doc;
+        for(auto k(0); k < 3; ++k)
+        {
+            TEST_ASSERT_NS(doc.readFromStr(big.getWriteToStr<WSMinified>()));
+            TEST_ASSERT_NS(doc.getRoot().getSizeArr() == 5000);
+            TEST_ASSERT_NS(doc[4321]["i"].as<int>() == 4321);
+            TEST_ASSERT_NS(doc[4321]["s"].as<Str>() == "4321");
+            TEST_ASSERT_NS(doc[4321]["a"][1].as<int>() == 4322);
+        }
+
+        TEST_ASSERT_NS(doc.toVal() == big);
+
+        // Deeply nested containers
+        std::string deep(500, '[');
+        deep += "1";
+        deep += std::string(500, ']');
+
+        auto dDoc(Document::fromStr(std::string_view{deep}));
+        auto dv(dDoc.getRoot());
+        for(auto i(0); i < 500; ++i) dv = dv[0];
+        TEST_ASSERT_NS(dv.as<int>() == 1);
+        TEST_ASSERT_NS(dDoc.toVal() == fromStr(deep));
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Files are read through a mapped view
+        const ssvufs::Path path{"./ssvu_json_test_file.json"};
+        const ssvufs::Path emptyPath{"./ssvu_json_test_empty.json"};
+
+        auto v(mkObj("a", mkArr(1, 2.5, "s", true, Nll{}), "b", "x//y"));
+        v.writeToFile<WSPretty>(path);
+        std::ofstream{emptyPath.getCStr(), std::ios_base::trunc};
+
+        ssvufs::MappedFile file{path};
+        TEST_ASSERT_NS(file.getView() == v.getWriteToStr<WSPretty>());
+
+        auto movedFile(std::move(file));
+        TEST_ASSERT_NS(file.getView().empty());
+        TEST_ASSERT_NS(movedFile.getSize() == movedFile.getView().size());
+
+        TEST_ASSERT_NS(ssvufs::MappedFile{emptyPath}.getView().empty());
+        TEST_ASSERT_NS(!ssvufs::MappedFile{}.open("./ssvu_missing.json"));
+
+        TEST_ASSERT_NS(fromFile(path) == v);
+        TEST_ASSERT_NS(fromFile<RSInSitu>(path) == v);
+        TEST_ASSERT_NS(fromFile<RSIndexed>(path) == v);
+        TEST_ASSERT_NS(Document::fromFile(path).toVal() == v);
+
+        auto doc(Document::fromFile(path));
+        TEST_ASSERT_NS(doc["b"].as<std::string_view>() == "x//y");
+
+        ssvufs::removeFile(path);
+        ssvufs::removeFile(emptyPath);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        // Every writing backend produces the same output, including
+        // documents bigger than the sink buffer
+        Val big{Arr{}};
+        for(auto i(0); i < 20000; ++i)
+            big.emplace(mkObj("i", i, "s", "abcdefghij", "r", i * 0.5));
+
+        const Str longStr(writerBufSize * 2 + 17, 'x');
+        big.emplace(longStr);
+
+        const auto expected(big.getWriteToStr<WSMinified>());
+        TEST_ASSERT_NS(expected.size() > writerBufSize * 4);
+        TEST_ASSERT_NS(fromStr(expected) == big);
+
+        std::ostringstream o;
+        big.writeToStream<WSMinified>(o);
+        TEST_ASSERT_NS(o.str() == expected);
+
+        const ssvufs::Path path{"./ssvu_json_test_writer.json"};
+
+        TEST_ASSERT_NS(big.writeToFile<WSMinified>(path));
+        TEST_ASSERT_NS(path.getContentsAsStr() == expected);
+
+        auto file(std::fopen(path.getCStr(), "wb"));
+        TEST_ASSERT_NS(big.writeToCFile<WSMinified>(file));
+        std::fclose(file);
+        TEST_ASSERT_NS(path.getContentsAsStr() == expected);
+
+        auto fd(::open(path.getCStr(), O_WRONLY | O_TRUNC));
+        TEST_ASSERT_NS(big.writeToFd<WSMinified>(fd));
+        ::close(fd);
+        TEST_ASSERT_NS(path.getContentsAsStr() == expected);
+
+        // Appending to an existing string is not supported: it is replaced
+        std::string str{"garbage"};
+        big.writeToStr<WSMinified>(str);
+        TEST_ASSERT_NS(str == expected);
+
+        // Pretty output is unchanged by the sink
+        std::ostringstream oPretty;
+        big.writeToStream(oPretty);
+        TEST_ASSERT_NS(oPretty.str() == big.getWriteToStr());
+
+        // NDJSON writing
+        const auto& arr(big.as<Arr>());
+        const auto nd(getWriteToStrNd(arr));
+        TEST_ASSERT_NS(writeToFileNd(path, arr));
+        TEST_ASSERT_NS(path.getContentsAsStr() == nd);
+        TEST_ASSERT_NS(fromStrNd(nd) == arr);
+
+        // Failing sinks are reported
+        TEST_ASSERT_NS(!big.writeToFd<WSMinified>(-1));
+        TEST_ASSERT_NS(!big.writeToFile(ssvufs::Path{"./missing/dir.json"}));
+
+        ssvufs::removeFile(path);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        auto readStr([](const std::string& mSrc) {
+            const auto r(fromStr(mSrc));
+            return r.as<Str>();
+        });
+
+        // Strings are escaped when written and read back unchanged
+        Str all;
+        for(auto c(1); c < 128; ++c) all += char(c);
+        all += "\xC3\xA8\xE2\x82\xAC";
+
+        const Val v{mkObj("k\"\\\n", all)};
+        TEST_ASSERT_NS(fromStr(v.getWriteToStr()) == v);
+        TEST_ASSERT_NS(fromStr<RSInSitu>(v.getWriteToStr()) == v);
+        TEST_ASSERT_NS(Val{"a\"b\\c\n\x01/"}.getWriteToStr() ==
+                       R"("a\"b\\c\n\u0001/")");
+
+        // Escapes at every offset, across SIMD block boundaries
+        for(auto len(0u); len < 80; ++len)
+            for(auto pos(0u); pos < len; ++pos)
+            {
+                Str s(len, 'x');
+                s[pos] = pos % 3 == 0 ? '"' : pos % 3 == 1 ? '\x1F' : '\\';
+
+                const auto w(Val{s}.getWriteToStr());
+                TEST_ASSERT_NS(readStr(w) == s);
+                TEST_ASSERT_NS(findEscape(s.data(), s.size()) == pos);
+            }
+
+        // Unicode escape sequences are decoded to UTF-8
+        TEST_ASSERT_NS(readStr(R"("A\u00e8\u20AC")") ==
+                       "A\xC3\xA8\xE2\x82\xAC");
+        TEST_ASSERT_NS(readStr(R"("\ud83d\ude00!")") ==
+                       "\xF0\x9F\x98\x80!");
+
+        // Unpaired surrogates are replaced
+        TEST_ASSERT_NS(readStr(R"("\ud83dx")") == "\xEF\xBF\xBDx");
+        TEST_ASSERT_NS(readStr(R"("\ude00")") == "\xEF\xBF\xBD");
+
+        // Invalid escape sequences are rejected
+        for(auto src : {R"("\u12")", R"("\u12g4")", R"("\x")", R"(["\q"])"})
+        {
+            Val r;
+            Reader<> reader{std::string{src}};
+            TEST_ASSERT_NS(!tryParse(r, reader));
+        }
+
+        // Unicode escapes split across chunks
+        const std::string chunked{R"(["\u00e8\ud83d\ude00", "\u0041"] )"};
+        for(auto split(0u); split < chunked.size(); ++split)
+        {
+            ChunkReader cr;
+            Val result;
+            auto onVal([&result](Val&& mV) { result = std::move(mV); });
+
+            cr.feedVals(chunked.substr(0, split), onVal);
+            cr.feedVals(chunked.substr(split), onVal);
+            TEST_ASSERT_NS(result == fromStr(chunked));
+        }
+
+        const std::string docSrc{R"({"\u0041": "\u00e8"})"};
+        auto doc(Document::fromStr(std::string_view{docSrc}));
+        TEST_ASSERT_NS(doc["A"].as<Str>() == "\xC3\xA8");
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Pretty output is indented by four spaces per level, also past the
+        // precomputed indentation levels
+        Val deep{1};
+        for(auto i(0); i < 40; ++i) deep = Val{mkArr(std::move(deep))};
+
+        const auto pretty(deep.getWriteToStr<WSPretty>());
+        auto lines(getSplit(pretty, '\n'));
+        TEST_ASSERT_NS(lines.size() == 81);
+
+        for(auto i(0u); i < lines.size(); ++i)
+        {
+            const auto level(i <= 40 ? i : 80 - i);
+            const auto& l(lines[i]);
+            const auto text(l.substr(l.find_first_not_of(' ')));
+
+            TEST_ASSERT_NS(l.size() - text.size() == level * 4);
+            TEST_ASSERT_NS(text == (i < 40 ? "[" : i == 40 ? "1" : "]"));
+        }
+
+        TEST_ASSERT_NS(fromStr(pretty) == deep);
+
+        // Log output only adds console formatting to pretty output
+        auto log(mkObj("a", mkArr(1, "s", true, Nll{}), "b", 2.5)
+                     .getWriteToStr<WSPrettyLog>());
+        for(auto p(log.find('\x1b')); p != std::string::npos;
+            p = log.find('\x1b'))
+            log.erase(p, log.find('m', p) - p + 1);
+
+        TEST_ASSERT_NS(log == mkObj("a", mkArr(1, "s", true, Nll{}), "b", 2.5)
+                                  .getWriteToStr<WSPretty>());
+        TEST_ASSERT_NS(deep.getWriteToStr<WSMinified>() ==
+                       std::string(40, '[') + "1" + std::string(40, ']'));
+
+        // Integer limits are written exactly
+        const auto limits(mkArr(std::numeric_limits<IntS>::min(),
+            std::numeric_limits<IntS>::max(),
+            std::numeric_limits<IntU>::max(), 0));
+        TEST_ASSERT_NS(limits.getWriteToStr<WSMinified>() ==
+                       "[" + toStr(std::numeric_limits<IntS>::min()) + "," +
+                           toStr(std::numeric_limits<IntS>::max()) + "," +
+                           toStr(std::numeric_limits<IntU>::max()) + ",0]");
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        // Binary round-trips preserve number representations exactly
+        const auto src(mkObj("ints", mkArr(std::numeric_limits<IntS>::min(),
+                                         std::numeric_limits<IntS>::max(), -1,
+                                         0, IntU(1),
+                                         std::numeric_limits<IntU>::max()),
+            "reals", mkArr(0.1, -2.5e300, 1.0, -0.0), "str",
+            std::string{"a\0b\"\n", 5}, "empty", mkArr(mkArr(), mkObj(), ""),
+            "misc", mkArr(true, false, Nll{}), "nested",
+            mkObj("z", 1, "a", mkObj("k", mkArr(1, 2, 3)))));
+
+        const auto bin(src.getWriteToBinStr());
+        const auto v(fromBinStr(bin));
+        TEST_ASSERT_NS(v == src);
+        TEST_ASSERT_NS(v.getWriteToStr() == src.getWriteToStr());
+
+        const auto& ints(v["ints"].as<Arr>());
+        TEST_ASSERT_NS(ints[0].as<IntS>() == std::numeric_limits<IntS>::min());
+        TEST_ASSERT_NS(ints[4].is<IntU>() && !ints[4].is<IntS>());
+        TEST_ASSERT_NS(ints[5].as<IntU>() == std::numeric_limits<IntU>::max());
+        TEST_ASSERT_NS(v["reals"][2].is<Real>());
+        TEST_ASSERT_NS(v["str"].as<Str>().size() == 5);
+
+        // Small values take a few bytes
+        TEST_ASSERT_NS(Val{Nll{}}.getWriteToBinStr().size() == 1);
+        TEST_ASSERT_NS(Val{5}.getWriteToBinStr().size() == 2);
+        TEST_ASSERT_NS(Val{"abc"}.getWriteToBinStr().size() == 5);
+
+        // Truncated or corrupted input is rejected
+        for(auto i(0u); i < bin.size(); ++i)
+        {
+            bool thrown{false};
+            try
+            {
+                BinReader{std::string_view{bin}.substr(0, i)}.readAll();
+            }
+            catch(const ReadException&)
+            {
+                thrown = true;
+            }
+            TEST_ASSERT_NS(thrown);
+        }
+
+        for(const auto& bad : {std::string{"\x09"}, std::string{"\x00\x00", 2},
+                std::string{"\x07\xFF\xFF\xFF\xFF\x0F"},
+                std::string{"\x06\x05" "abc"}})
+        {
+            bool thrown{false};
+            try
+            {
+                BinReader{bad}.readAll();
+            }
+            catch(const ReadException&)
+            {
+                thrown = true;
+            }
+            TEST_ASSERT_NS(thrown);
+        }
+
+        // Out-of-order keys are still inserted in order
+        const std::string unordered{"\x08\x02\x01"
+                                    "b\x02\x01"
+                                    "a\x01"};
+        const auto uv(fromBinStr(unordered));
+        TEST_ASSERT_NS(uv == mkObj("a", false, "b", true));
+
+        // Files
+        const ssvufs::Path path{"./_json_bin_test.bin"};
+        TEST_ASSERT_NS(src.writeToBinFile(path));
+        TEST_ASSERT_NS(fromBinFile(path) == src);
+        std::remove(path.getCStr());
+
+        std::ostringstream oss;
+        src.writeToBinStream(oss);
+        TEST_ASSERT_NS(oss.str() == bin);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Parallel parsing of top-level arrays matches serial parsing
+        std::string src{"// Records\n[\n"};
+        for(auto i(0); i < 2000; ++i)
+        {
+            const auto si(toStr(i));
+            src += "    { \"id\": " + si + ", \"s\": \"],}[{,\\\"\\\\\", " +
+                   "\"a\": [" + si + ".5, [], {}, null, true] }, // c ] ,\n";
+        }
+        src += "    \"last\" ]  ";
+
+        const auto serial(fromStr(src));
+        TEST_ASSERT_NS(serial.getSizeArr() == 2001);
+        TEST_ASSERT_NS(serial[1]["s"].as<Str>() == "],}[{,\"\\");
+
+        TEST_ASSERT_NS(fromStrParallel(src, 4) == serial);
+        TEST_ASSERT_NS(fromStrParallel<RSInSitu>(src, 3) == serial);
+        TEST_ASSERT_NS(fromStrParallel<RSIndexed>(src, 8) == serial);
+        TEST_ASSERT_NS(fromStrParallel(src, 1) == serial);
+        TEST_ASSERT_NS(fromStrParallel(src) == serial);
+
+        std::vector<std::string_view> elements;
+        TEST_ASSERT_NS(ssvu::Json::Impl::splitArrElements(src, elements));
+        TEST_ASSERT_NS(elements.size() == 2001);
+
+        // Other values, empty and malformed arrays
+        for(const auto& s : {std::string{"{\"a\": [1, 2]}"}, std::string{"[]"},
+                std::string{" [ ] "}, std::string{"5"}})
+            TEST_ASSERT_NS(fromStrParallel(s, 4) == fromStr(s));
+
+        for(const auto& bad :
+            {src + ",", src.substr(0, src.size() - 4) + ",]",
+                "[" + std::string(1000, '1') + "," + src.substr(1),
+                src.substr(0, src.size() - 10)})
+            TEST_ASSERT_NS(fromStrParallel<RSInSitu>(bad, 4) ==
+                           fromStr<RSInSitu>(bad));
+
+        std::string twoVals{src};
+        twoVals.replace(twoVals.find("\"last\""), 6, "1 2");
+        TEST_ASSERT_NS(fromStrParallel<RSInSitu>(twoVals, 4).is<Nll>());
+
+        // Top-level arrays of numbers are stored as serial parsing does
+        std::string ints{"["}, reals{"["};
+        for(auto i(0); i < 20000; ++i)
+        {
+            ints += (i == 0 ? "" : ", ") + toStr(i);
+            reals += (i == 0 ? "" : ", ") + toStr(i) + ".5";
+        }
+        ints += "]";
+        reals += "]";
+
+        using RSNA = RSInSituNumArrs;
+        const auto vInts(fromStrParallel<RSNA>(ints, 4));
+        const auto vReals(fromStrParallel<RSNA>(reals, 4));
+        TEST_ASSERT_NS(fromStr<RSNA>(ints).isNumArr<IntS>());
+        TEST_ASSERT_NS(vInts.isNumArr<IntS>() && vInts == fromStr(ints));
+        TEST_ASSERT_NS(fromStr<RSNA>(reals).isNumArr<Real>());
+        TEST_ASSERT_NS(vReals.isNumArr<Real>() && vReals == fromStr(reals));
+        TEST_ASSERT_NS(!fromStrParallel<RSNA>(src, 4).isNumArr<Real>());
+        TEST_ASSERT_NS(!fromStrParallel(ints, 4).isNumArr<IntS>());
+        TEST_ASSERT_NS(vReals.as<Val::Arr>().size() == 20000);
+        TEST_ASSERT_NS(vReals.as<Val::Arr>()[19999].as<Real>() == 19999.5);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Pointer and path syntax
+        TEST_ASSERT_NS(Pointer::fromStr("").getTokens().empty());
+        TEST_ASSERT_NS(Pointer::fromStr("/a~1b/~0/0/").getTokens() ==
+                       (std::vector<std::string>{"a/b", "~", "0", ""}));
+        TEST_ASSERT_NS(Pointer::fromPath("a.b.0").getTokens() ==
+                       (std::vector<std::string>{"a", "b", "0"}));
+
+        for(const auto& bad : {"a", "/~", "/~2"})
+        {
+            bool thrown{false};
+            try
+            {
+                Pointer::fromStr(bad);
+            }
+            catch(const std::runtime_error&)
+            {
+                thrown = true;
+            }
+            TEST_ASSERT_NS(thrown);
+        }
+
+        // Queries only read the requested value
+        const std::string src{R"(// Config
+{
+    "window": { "size": [800, 600], "title": "a ] } \" , b" },
+    "renderer":
+    {
+        "skip": [{ "x": "}" }, [[], {}], -1.5e3, true, null], // } ]
+        "shadows": { "enabled": false, "resolution": 2048 },
+        "a/b": 1, "~": 2, "": 3
+    },
+    "renderer": "duplicate"
+})"};
+
+        const auto full(fromStr(src));
+        const auto check([&](const Pointer& mP, const Val& mExpected) {
+            TEST_ASSERT_NS(queryStr(src, mP) == mExpected);
+            TEST_ASSERT_NS(queryStr<RSDefault>(src, mP) == mExpected);
+            TEST_ASSERT_NS(queryStr<RSIndexed>(src, mP) == mExpected);
+        });
+
+        check(Pointer::fromPath("renderer.shadows.resolution"), 2048);
+        check(Pointer::fromStr("/renderer/shadows/enabled"), false);
+        check(Pointer::fromStr("/window/title"), "a ] } \" , b");
+        check(Pointer::fromStr("/window/size/1"), 600);
+        check(Pointer::fromStr("/renderer/skip/0/x"), "}");
+        check(Pointer::fromStr("/renderer/skip/2"), -1.5e3);
+        check(Pointer::fromStr("/renderer/skip/1"), mkArr(mkArr(), mkObj()));
+        check(Pointer::fromStr("/renderer/a~1b"), 1);
+        check(Pointer::fromStr("/renderer/~0"), 2);
+        check(Pointer::fromStr("/renderer/"), 3);
+        check(Pointer::fromStr("/window"), full["window"]);
+        check(Pointer::fromStr(""), full);
+
+        // Missing values leave the output untouched
+        for(const auto& missing :
+            {"/nope", "/window/size/2", "/window/size/x", "/window/size/01a",
+                "/window/size/01", "/window/size/00", "/window/size/+1",
+                "/window/title/0", "/renderer/skip/-", "/renderer/skip/4/0"})
+        {
+            Val out{"untouched"};
+            TEST_ASSERT_NS(!queryFromStr(src, Pointer::fromStr(missing), out));
+            TEST_ASSERT_NS(out == "untouched");
+        }
+
+        // Malformed documents are reported as errors
+        Val out;
+        TEST_ASSERT_NS(!queryFromStr(std::string{R"({"a" 1, "b": 2})"},
+            Pointer::fromStr("/b"), out));
+        TEST_ASSERT_NS(!queryFromStr(std::string{R"({"a": "1, "b": 2})"},
+            Pointer::fromStr("/b"), out));
+        TEST_ASSERT_NS(!queryFromStr(std::string{R"({"a": 1, "b": [1,})"},
+            Pointer::fromStr("/b"), out));
+        TEST_ASSERT_NS(out.is<Nll>());
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Wide objects, with keys in any order, sorted or hashed
+        std::string src{"{"};
+        for(auto i(0); i < 5000; ++i)
+        {
+            const auto k(toStr((i * 7919) % 5000));
+            src += (i == 0 ? "\"k" : ", \"k") + k + "\": " + k;
+        }
+        src += "}";
+
+        auto check([&src](const auto& mV) {
+            using V = std::decay_t<decltype(mV)>;
+
+            const auto v(V::fromStr(src));
+            TEST_ASSERT_NS(v.getSizeObj() == 5000);
+
+            for(auto i(0); i < 5000; ++i)
+            {
+                const auto k("k" + toStr(i));
+                TEST_ASSERT_NS(v.has(k) && v[k].template as<int>() == i);
+            }
+
+            TEST_ASSERT_NS(
+                !v.has("k5000") && v["k5000"].template is<Nll>());
+            TEST_ASSERT_NS(V::fromStr(v.getWriteToStr()) == v);
+            TEST_ASSERT_NS(V::fromBinStr(v.getWriteToBinStr()) == v);
+        });
+
+        check(Val{});
+        check(HashedVal{});
+        TEST_ASSERT_NS(Document::fromStr(src).toVal() == fromStr(src));
+
+        // Of duplicate keys, the last value is kept. Hashed objects keep
+        // the keys in the order they were first read.
+        const std::string dupSrc{R"({"b": 1, "a": 2, "c": 3, "a": 4})"};
+        const auto dup(fromStr(dupSrc));
+        const auto hDup(HashedVal::fromStr(dupSrc));
+        TEST_ASSERT_NS(
+            dup.getWriteToStr<WSMinified>() == R"({"a":4,"b":1,"c":3})");
+        TEST_ASSERT_NS(
+            hDup.getWriteToStr<WSMinified>() == R"({"b":1,"a":4,"c":3})");
+        TEST_ASSERT_NS(HashedVal::fromBinStr(hDup.getWriteToBinStr())
+                           .getWriteToStr<WSMinified>() ==
+                       R"({"b":1,"a":4,"c":3})");
+
+        std::string keys;
+        for(const auto& p : hDup.forObj()) keys += p.key;
+        TEST_ASSERT_NS(keys == "bac");
+
+        // Both representations share their layout and conversions
+        static_assert(!std::is_same_v<Val, HashedVal>);
+        static_assert(sizeof(HashedVal) == sizeof(Val));
+
+        HashedVal h{HashedVal::Obj{}};
+        h["z"] = std::vector<int>{1, 2, 3};
+        h["y"] = std::make_pair(4, "four");
+        h["x"] = HashedVal::fromStr(R"({"nested": [true, null]})");
+        TEST_ASSERT_NS(h["z"].as<std::vector<int>>().size() == 3);
+        TEST_ASSERT_NS((h["y"].as<std::pair<int, Str>>().second == "four"));
+        TEST_ASSERT_NS(h["x"]["nested"][0].as<bool>());
+        TEST_ASSERT_NS(h.getWriteToStr<WSMinified>() ==
+                       R"({"z":[1,2,3],"y":[4,"four"],)"
+                       R"("x":{"nested":[true,null]}})");
+
+        // User-defined converters work with both
+        TestCnvWindow w{"main", 640, 480, true};
+        HashedVal hw;
+        arch(hw, w);
+        TEST_ASSERT_NS(hw.getWriteToStr<WSMinified>() ==
+                       R"({"title":"main","width":640,"height":480,)"
+                       R"("fullscreen":true})");
+
+        const auto wOut(getExtr<TestCnvWindow>(hw));
+        TEST_ASSERT_NS(wOut.title == "main" && wOut.height == 480);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Document keys are views into the source, or are interned once in
+        // a table passed to the constructor
+        const std::string src{R"([
+            {"id": 0, "name": "a", "": 1, "t\u0061g": "x"},
+            {"id": 1, "name": "b", "": 2, "tag": "y"},
+            {"name": "c", "id": 2}
+        ])"};
+
+        auto check([](const Document& mDoc) {
+            TEST_ASSERT_NS(mDoc[0]["id"].as<int>() == 0);
+            TEST_ASSERT_NS(mDoc[1]["name"].as<std::string_view>() == "b");
+            TEST_ASSERT_NS(mDoc[2]["id"].as<int>() == 2);
+            TEST_ASSERT_NS(mDoc[0][""].as<int>() == 1);
+            TEST_ASSERT_NS(mDoc[0]["tag"].as<std::string_view>() == "x");
+            TEST_ASSERT_NS(mDoc[1]["tag"].as<std::string_view>() == "y");
+            TEST_ASSERT_NS(!mDoc[2].has("tag") && !mDoc[2].has(""));
+            TEST_ASSERT_NS(!mDoc[0].has("nope") && !mDoc[0].has("t"));
+            TEST_ASSERT_NS(mDoc[0]["nope"].getType() == Val::Type::TNll);
+        });
+
+        Document doc;
+        TEST_ASSERT_NS(doc.readFromStr(src));
+        check(doc);
+        TEST_ASSERT_NS(doc.toVal() == fromStr(src));
+
+        const auto id0((*std::begin(doc[0].forObj())).first);
+        TEST_ASSERT_NS(id0 == "id" && id0.data() >= src.data() &&
+                       id0.data() < src.data() + src.size());
+
+        KeyTable keys;
+        Document a{keys}, b{keys};
+        TEST_ASSERT_NS(a.readFromStr(src) && b.readFromStr(src));
+        TEST_ASSERT_NS(keys.getSize() == 4);
+        check(a);
+        check(b);
+
+        // Iterated keys are the interned copies
+        for(const auto& p : a[0].forObj())
+            TEST_ASSERT_NS(p.first.data() == keys.find(p.first).data());
+
+        // Reading again does not invalidate the keys of other documents
+        TEST_ASSERT_NS(a.readFromStr(std::string{R"({"other": true})"}));
+        TEST_ASSERT_NS(keys.getSize() == 5);
+        TEST_ASSERT_NS(a["other"].as<bool>() && !a.getRoot().has("id"));
+        check(b);
+
+        auto moved(std::move(b));
+        check(moved);
+
+        // Interned keys are looked up by address
+        const auto id(keys.intern("id"));
+        TEST_ASSERT_NS(id.data() == keys.find("id").data());
+        TEST_ASSERT_NS(moved[2][id].as<int>() == 2);
+        TEST_ASSERT_NS(moved[2][id.substr(0, 1)].is<Nll>());
+        TEST_ASSERT_NS(keys.find("missing").data() == nullptr);
+        TEST_ASSERT_NS(keys.intern("").data() != nullptr);
+
+        KeyTable many;
+        for(auto i(0); i < 1000; ++i) many.intern(toStr(i % 500));
+        TEST_ASSERT_NS(many.getSize() == 500);
+        for(auto i(0); i < 500; ++i)
+            TEST_ASSERT_NS(many.find(toStr(i)) == toStr(i));
+
+        many.clear();
+        TEST_ASSERT_NS(many.getSize() == 0);
+        TEST_ASSERT_NS(many.find("0").data() == nullptr);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Streamable converters read the source without building a `Val`
+        TestCnvConfig c;
+        c.window = {"main \"window\"", 800, 600, true};
+        c.others = {{"a", 1, 2, false}, {"b", 3, 4, true}};
+        c.ids = {5, 6, 7};
+        c.scale = 2.5f;
+        c.pos = {-1, 1};
+
+        const auto v(getArch(c));
+        const auto src(v.getWriteToStr<WSPretty>());
+
+        TestCnvConfig out;
+        TEST_ASSERT_NS(extrFromStr(src, out));
+        TEST_ASSERT_NS(getArch(out) == v);
+        TEST_ASSERT_NS(getArch(getExtrFromStr<TestCnvConfig>(src)) == v);
+        TEST_ASSERT_NS(
+            getArch(getExtrFromStr<TestCnvConfig, RSInSitu>(src)) == v);
+
+        // Keys are matched in any order, unknown keys are skipped and
+        // missing keys are left untouched
+        TestCnvWindow w{"untouched", 1, 2, false};
+        TEST_ASSERT_NS(extrFromStr(std::string{R"({
+            "fullscreen": true, "unknown": [{"title": "x"}, "]"],
+            // comment
+            "height": 10, "width": 20, "extra": {}
+        })"},
+            w));
+        TEST_ASSERT_NS(w.title == "untouched" && w.width == 20);
+        TEST_ASSERT_NS(w.height == 10 && w.fullscreen);
+
+        // Scalars of the wrong type are ignored
+        TEST_ASSERT_NS(extrFromStr(
+            std::string{R"({"width": "wide", "height": [1], "title": 5})"},
+            w));
+        TEST_ASSERT_NS(w.title == "untouched" && w.width == 20);
+        TEST_ASSERT_NS(w.height == 10);
+
+        // Other converters are used through a temporary `Val`
+        using Type = ssvu::Json::Impl::__ssvjTestStruct;
+        std::vector<Type> structs(3);
+        structs[1].f0 = 42;
+        structs[2].f3 = "changed";
+
+        std::vector<Type> outStructs;
+        TEST_ASSERT_NS(
+            extrFromStr(getArch(structs).getWriteToStr(), outStructs));
+        TEST_ASSERT_NS(outStructs == structs);
+
+        // Reading errors are reported
+        TEST_ASSERT_NS(!extrFromStr(std::string{R"({"width": 1,})"}, w));
+        TEST_ASSERT_NS(!extrFromStr(std::string{R"([1, 2])"}, w));
+        TEST_ASSERT_NS(!extrFromStr(std::string{R"({"ids": [1, ]})"}, c));
+
+        const ssvufs::Path path{"./ssvu_json_cnv_test.json"};
+        v.writeToFile(path);
+        TEST_ASSERT_NS(getArch(getExtrFromFile<TestCnvConfig>(path)) == v);
+        ssvufs::removeFile(path);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Compact values: one tag for types and number representations,
+        // containers and strings stored in place or, if copy-on-write,
+        // boxed
+        static_assert(sizeof(Val) == sizeof(Str) + sizeof(void*));
+        static_assert(sizeof(CowVal) == 16);
+
+        Val v{mkObj("a", mkArr(1u, -2, 3.5), "b", "str", "c", true)};
+        TEST_ASSERT_NS(v["a"][0].is<IntU>() && v["a"][1].is<IntS>());
+        TEST_ASSERT_NS(v["a"][2].is<Real>() && v["a"][2].as<Real>() == 3.5);
+        TEST_ASSERT_NS(v["b"].getType() == Val::Type::TStr);
+
+        v["a"][0] = -7;
+        TEST_ASSERT_NS(v["a"][0].is<IntS>() && v["a"][0].as<int>() == -7);
+
+        // Moved-from values are left null
+        auto copy(v);
+        auto moved(std::move(copy));
+        TEST_ASSERT_NS(moved == v && copy.is<Nll>());
+
+        // Values can be assigned from their own children
+        auto self(v);
+        self = self["a"];
+        TEST_ASSERT_NS(self == v["a"]);
+        self = std::move(self[2]);
+        TEST_ASSERT_NS(self.as<Real>() == 3.5);
+        self = self;
+        TEST_ASSERT_NS(self.as<Real>() == 3.5);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Every container and string is allocated once, with its exact
+        // size. Values store them in place: only non-empty containers and
+        // long strings allocate a block. Copy-on-write values also
+        // allocate a box for each of them, as do numeric arrays. The first
+        // count covers the reader itself.
+        static_assert(std::is_nothrow_move_constructible_v<Val>);
+        static_assert(std::is_nothrow_move_constructible_v<CowVal>);
+
+        auto countAllocs([](auto mV, const std::string& mSrc,
+                             bool mNumArrs = false) {
+            const auto before(allocCount.load());
+            if(mNumArrs)
+                mV.template readFromStr<RSInSituNumArrs>(mSrc);
+            else
+                mV.template readFromStr<RSInSitu>(mSrc);
+            return allocCount.load() - before;
+        });
+
+        const auto base(countAllocs(Val{}, "0"));
+        const auto cowBase(countAllocs(CowVal{}, "0"));
+
+        std::string nums{"["};
+        for(auto i(0); i < 50; ++i) nums += std::to_string(i) + ",";
+        nums.back() = ']';
+
+        const std::string nested{"[[], [[]], {}]"};
+        const std::string mixed{R"({"a": [1, 2], "b": {"c": "short"},
+            "d": "a string long enough to be allocated"})"};
+
+        TEST_ASSERT_NS(countAllocs(Val{}, nums) - base == 1);
+        TEST_ASSERT_NS(countAllocs(Val{}, nums, true) - base == 2);
+        TEST_ASSERT_NS(countAllocs(Val{}, nested) - base == 2);
+        TEST_ASSERT_NS(countAllocs(Val{}, mixed) - base == 4);
+
+        TEST_ASSERT_NS(countAllocs(CowVal{}, nums) - cowBase == 2);
+        TEST_ASSERT_NS(countAllocs(CowVal{}, nums, true) - cowBase == 2);
+        TEST_ASSERT_NS(
+            countAllocs(CowVal{}, nested) - cowBase == 2 + 2 + 3);
+        TEST_ASSERT_NS(countAllocs(CowVal{}, mixed) - cowBase ==
+                       2 + 2 + 2 + 1 + 2);
+
+        // Nested containers keep their items in order
+        const auto v(fromStr(R"([1, [2, {"x": [3, 4], "y": {}}], [], 5])"));
+        TEST_ASSERT_NS(v.getWriteToStr<WSMinified>() ==
+                       R"([1,[2,{"x":[3,4],"y":{}}],[],5])");
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Diffs only contain the changed values
+        const auto from(fromStr(R"({"name": "cfg", "size": [640, 480],
+            "tags": ["a", "b", "c"], "old": 1, "deep": {"x": {"y": 1}}})"));
+        const auto to(fromStr(R"({"name": "cfg", "size": [800, 480],
+            "tags": ["a"], "new": {"k": null}, "deep": {"x": {"y": "1"}},
+            "a/b~": true})"));
+
+        const auto d(diff(from, to));
+        TEST_ASSERT_NS(d.getSizeArr() == 7);
+        TEST_ASSERT_NS(diff(from, from).isEmptyArr());
+        TEST_ASSERT_NS(diff(to, Val{to}).isEmptyArr());
+
+        auto hasOp([&](const char* mOp, const char* mPath) {
+            for(const auto& op : d.forArr())
+                if(op["op"] == mOp && op["path"] == mPath) return true;
+
+            return false;
+        });
+
+        TEST_ASSERT_NS(hasOp("replace", "/size/0"));
+        TEST_ASSERT_NS(hasOp("remove", "/tags/2"));
+        TEST_ASSERT_NS(hasOp("remove", "/tags/1"));
+        TEST_ASSERT_NS(hasOp("remove", "/old"));
+        TEST_ASSERT_NS(hasOp("replace", "/deep/x/y"));
+        TEST_ASSERT_NS(hasOp("add", "/new") && !hasOp("add", "/new/k"));
+        TEST_ASSERT_NS(!hasOp("add", "/a/b~") && hasOp("add", "/a~1b~0"));
+
+        // Applying a diff turns the source into the target
+        auto v(from);
+        applyPatch(v, d);
+        TEST_ASSERT_NS(v == to);
+        applyPatch(v, diff(v, from));
+        TEST_ASSERT_NS(v == from);
+
+        auto root(from);
+        applyPatch(root, diff(root, Val{1}));
+        TEST_ASSERT_NS(root == Val{1});
+
+        // Operations from RFC 6902
+        v = fromStr(R"({"foo": ["bar", "baz"], "obj": {"a": 1}})");
+        applyPatch(v, fromStr(R"([
+            {"op": "add", "path": "/foo/1", "value": "qux"},
+            {"op": "add", "path": "/foo/-", "value": "end"},
+            {"op": "test", "path": "/foo/2", "value": "baz"},
+            {"op": "move", "from": "/obj/a", "path": "/obj/b"},
+            {"op": "copy", "from": "/obj", "path": "/copy"},
+            {"op": "replace", "path": "/copy/b", "value": 2},
+            {"op": "remove", "path": "/foo/0"}
+        ])"));
+        TEST_ASSERT_NS(v == fromStr(R"({"foo": ["qux", "baz", "end"],
+            "obj": {"b": 1}, "copy": {"b": 2}})"));
+
+        // Failing operations throw
+        auto throws([&](const char* mPatch) {
+            try
+            {
+                applyPatch(v, fromStr(mPatch));
+            }
+            catch(const std::runtime_error&)
+            {
+                return true;
+            }
+
+            return false;
+        });
+
+        TEST_ASSERT_NS(throws(R"([{"op": "test", "path": "/foo/0",
+            "value": "bar"}])"));
+        TEST_ASSERT_NS(throws(R"([{"op": "remove", "path": "/missing"}])"));
+        TEST_ASSERT_NS(throws(R"([{"op": "remove", "path": "/foo/3"}])"));
+        TEST_ASSERT_NS(throws(R"([{"op": "remove", "path": "/foo/01"}])"));
+        TEST_ASSERT_NS(throws(R"([{"op": "add", "path": "/foo/0/x",
+            "value": 1}])"));
+        TEST_ASSERT_NS(throws(R"([{"op": "move", "from": "/obj",
+            "path": "/obj/b"}])"));
+        TEST_ASSERT_NS(throws(R"([{"op": "nope", "path": ""}])"));
+        TEST_ASSERT_NS(throws(R"([{"path": ""}])"));
+        TEST_ASSERT_NS(throws(R"({})"));
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        // Equal values have equal hashes, whatever their representation
+        TEST_ASSERT_NS(hash(Val{1}) == hash(Val{1u}));
+        TEST_ASSERT_NS(hash(Val{1}) == hash(Val{1.0}));
+        TEST_ASSERT_NS(hash(Val{-3}) == hash(Val{-3.0}));
+        TEST_ASSERT_NS(hash(Val{0.0}) == hash(Val{-0.0}));
+        TEST_ASSERT_NS(hash(Val{1}) != hash(Val{1.5}));
+        TEST_ASSERT_NS(hash(Val{1}) != hash(Val{"1"}));
+        TEST_ASSERT_NS(hash(Val{true}) != hash(Val{false}));
+        TEST_ASSERT_NS(hash(Val{Nll{}}) != hash(Val{false}));
+
+        // Hashes are consistent with structural equality, which compares
+        // numbers by value in both directions
+        TEST_ASSERT_NS(isStructEqual(Val{1}, Val{1.0}));
+        TEST_ASSERT_NS(isStructEqual(Val{1u}, Val{1}));
+        TEST_ASSERT_NS(!isStructEqual(Val{1}, Val{1.5}));
+        TEST_ASSERT_NS(!isStructEqual(Val{1.5}, Val{1}));
+        TEST_ASSERT_NS(!isStructEqual(Val{-1}, Val{IntU(-1)}));
+        TEST_ASSERT_NS(!isStructEqual(Val{1}, Val{"1"}));
+        TEST_ASSERT_NS(!std::equal_to<Val>{}(Val{1}, Val{1.5}));
+        TEST_ASSERT_NS(Hashed{Val{1}} != Hashed{Val{1.5}});
+        TEST_ASSERT_NS(Hashed{Val{1}} == Hashed{Val{1.0}});
+
+        const auto a(fromStr(R"({"x": [1, 2, {"y": null}], "z": "s"})"));
+        const auto b(mkObj("z", "s", "x", mkArr(1, 2.0, mkObj("y", Nll{}))));
+        TEST_ASSERT_NS(a == b && hash(a) == hash(b) && isStructEqual(a, b));
+        TEST_ASSERT_NS(hash(mkArr(1, 2)) != hash(mkArr(2, 1)));
+        TEST_ASSERT_NS(!isStructEqual(mkArr(1, 2), mkArr(2, 1)));
+        TEST_ASSERT_NS(hash(mkArr()) != hash(mkObj()));
+        TEST_ASSERT_NS(hash(mkArr(mkArr())) != hash(mkArr()));
+
+        // Numeric arrays equal regular arrays with the same values
+        std::string ints{"["};
+        Val reals{Val::Arr{}};
+        for(auto i(0); i < 20; ++i)
+        {
+            ints += std::to_string(i) + ",";
+            reals.emplace(i + 0.0);
+        }
+        ints.back() = ']';
+
+        const auto packed(fromStr<RSInSituNumArrs>(ints));
+        TEST_ASSERT_NS(packed.isNumArr<IntS>() && !reals.isNumArr<Real>());
+        TEST_ASSERT_NS(isStructEqual(packed, reals));
+        TEST_ASSERT_NS(isStructEqual(reals, packed));
+        TEST_ASSERT_NS(hash(packed) == hash(reals));
+        reals[19] = 19.5;
+        TEST_ASSERT_NS(!isStructEqual(packed, reals));
+
+        // Every value type is hashed, objects regardless of member order
+        const auto ha1(HashedVal::fromStr(R"({"x": 1, "y": [2]})"));
+        const auto ha2(HashedVal::fromStr(R"({"y": [2.0], "x": 1})"));
+        TEST_ASSERT_NS(isStructEqual(ha1, ha2) && hash(ha1) == hash(ha2));
+        TEST_ASSERT_NS(hash(CowVal::fromStr(R"({"x": 1, "y": [2]})")) ==
+                       hash(ha1));
+
+        // Values can be deduplicated in unordered containers
+        std::unordered_set<Val> nums{Val{1}, Val{1.5}, Val{1.0}, Val{1u}};
+        TEST_ASSERT_NS(nums.size() == 2);
+
+        std::unordered_set<HashedVal> hashedVals{ha1, ha2};
+        std::unordered_set<CowVal> cowVals{CowVal{1}, CowVal{"1"}};
+        TEST_ASSERT_NS(hashedVals.size() == 1 && cowVals.size() == 2);
+
+        std::unordered_set<Val> vals;
+        std::unordered_set<Hashed> hashed;
+        for(auto i(0); i < 100; ++i)
+        {
+            const auto v(mkObj("id", i % 10, "tags", mkArr("t", i % 10 < 5)));
+            vals.emplace(v);
+            hashed.emplace(v);
+        }
+
+        TEST_ASSERT_NS(vals.size() == 10 && hashed.size() == 10);
+        TEST_ASSERT_NS(hashed.count(Hashed{a}) == 0);
+        TEST_ASSERT_NS(hashed.count(Hashed{mkObj("id", 3, "tags",
+                           mkArr("t", true))}) == 1);
+
+        const Hashed ha{a}, hb{b};
+        TEST_ASSERT_NS(ha == hb && ha.getHash() == hash(a));
+        TEST_ASSERT_NS(ha != Hashed{Val{1}} && ha.getVal() == a);
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+        using namespace ssvu::Json::Impl;
+
+        std::string ints{"["}, reals{"["}, mixed{"[0.5"};
+        for(auto i(0); i < 100; ++i)
+        {
+            ints += std::to_string(i * 3 - 50) + ",";
+            reals += std::to_string(i) + ".5,";
+            mixed += "," + std::to_string(i);
+        }
+        ints.back() = reals.back() = ']';
+        mixed += "]";
+
+        // Homogeneous arrays of numbers are stored contiguously, if the
+        // reader settings enable it
+        using RSNA = RSInSituNumArrs;
+        auto vi(fromStr<RSNA>(ints));
+        const auto vr(fromStr<RSNA>(reals));
+        TEST_ASSERT_NS(vi.isNumArr<IntS>() && !vi.isNumArr<Real>());
+        TEST_ASSERT_NS(vr.isNumArr<Real>() && vr.getSizeArr() == 100);
+        TEST_ASSERT_NS(vi.getNumArr<IntS>()[10] == -20);
+        TEST_ASSERT_NS(vr.getNumArr<Real>().data()[99] == 99.5);
+        TEST_ASSERT_NS(!fromStr<RSNA>(mixed).isNumArr<Real>());
+        TEST_ASSERT_NS(fromStr<RSNA>(mixed)[1].is<IntS>());
+        TEST_ASSERT_NS(!fromStr<RSNA>("[1, 2, 3]").isNumArr<IntS>());
+        TEST_ASSERT_NS(!fromStr(reals).isNumArr<Real>());
+        TEST_ASSERT_NS(!fromStr<RSInSitu>(ints).isNumArr<IntS>());
+
+        // Const accesses see them as regular arrays, built once
+        const auto& arr(vr.as<Arr>());
+        TEST_ASSERT_NS(arr.size() == 100 && &arr == &vr.as<Arr>());
+        TEST_ASSERT_NS(arr[0] == 0.5 && arr[99].as<Real>() == 99.5);
+        TEST_ASSERT_NS(vr.isNumArr<Real>() && vr == fromStr(reals));
+
+        const Val& item(vr[3]);
+        TEST_ASSERT_NS(&item == &arr[3] && item.as<Real>() == 3.5);
+
+        // They behave like any other array
+        const auto& ci(vi);
+        TEST_ASSERT_NS(ci.is<Arr>() && ci.has(99) && !ci.has(100));
+        TEST_ASSERT_NS(ci[10].is<IntS>() && ci[10].as<int>() == -20);
+        TEST_ASSERT_NS(vr[0].is<Real>() && vr[0].as<Real>() == 0.5);
+        TEST_ASSERT_NS(vi.isNumArr<IntS>());
+
+        auto sum(0);
+        for(const auto& x : ci.forArrAs<int>()) sum += x;
+        TEST_ASSERT_NS(sum == 100 * 99 / 2 * 3 - 50 * 100);
+
+        TEST_ASSERT_NS(vi.is<std::vector<int>>());
+        TEST_ASSERT_NS(vr.is<std::vector<float>>());
+        TEST_ASSERT_NS(vr.as<std::vector<float>>()[1] == 1.5f);
+        TEST_ASSERT_NS(vi.getWriteToStr<WSMinified>() == ints);
+        TEST_ASSERT_NS(vr.getWriteToStr<WSMinified>() == reals);
+        TEST_ASSERT_NS(Val::fromBinStr(vr.getWriteToBinStr()) == vr);
+
+        Val generic{vr.as<Arr>()};
+        TEST_ASSERT_NS(!generic.isNumArr<Real>());
+        TEST_ASSERT_NS(generic == vr && vr == generic);
+        TEST_ASSERT_NS(hash(generic) == hash(vr));
+        TEST_ASSERT_NS(vr != vi && diff(vr, generic).isEmptyArr());
+
+        // Arrays stored differently are compared item by item
+        Val withStr{generic}, realInts;
+        withStr[99] = "99.5";
+        TEST_ASSERT_NS(vr != withStr && withStr != vr);
+        TEST_ASSERT_NS(vr != fromStr("[0.5, 1.5]") && vr != Val{Arr{}});
+
+        const auto& iItems(vi.getNumArr<IntS>());
+        realInts.setNumArr(
+            std::vector<Real>(std::begin(iItems), std::end(iItems)));
+        TEST_ASSERT_NS(realInts == vi && vi == realInts);
+        TEST_ASSERT_NS(vi.isNumArr<IntS>() && realInts.isNumArr<Real>());
+
+        auto copy(vi);
+        TEST_ASSERT_NS(copy.isNumArr<IntS>() && copy == vi);
+
+        // Concurrent const accesses share a single regular `Arr`
+        const auto vr2(fromStr<RSNA>(reals));
+        std::vector<std::thread> threads;
+        std::atomic<int> failures{0};
+        for(auto t(0); t < 4; ++t)
+            threads.emplace_back([&] {
+                for(auto i(0u); i < 100; ++i)
+                    if(vr2[i].as<Real>() != i + 0.5) ++failures;
+            });
+        for(auto& t : threads) t.join();
+        TEST_ASSERT_NS(failures == 0 && vr2.isNumArr<Real>());
+
+        // Mutable accesses turn them into regular arrays
+        vi[3] = "x";
+        TEST_ASSERT_NS(!vi.isNumArr<IntS>() && vi[3] == "x");
+        TEST_ASSERT_NS(vi[4].as<int>() == -38 && vi.getSizeArr() == 100);
+
+        copy.emplace(1.5);
+        TEST_ASSERT_NS(copy.getSizeArr() == 101 && copy[100].is<Real>());
+
+        Val set;
+        set.setNumArr(std::vector<Real>{1.0, 2.0});
+        TEST_ASSERT_NS(set.isNumArr<Real>() && set == fromStr("[1.0, 2.0]"));
+    }
+    {
+        using namespace ssvu;
+        using namespace ssvu::Json;
+
+        std::string nums{"["};
+        for(auto i(0); i < 20; ++i) nums += std::to_string(i) + ",";
+        nums.back() = ']';
+
+        // Copies of `CowVal` share their storage until they are mutated,
+        // copies of `Val` never do. Both behave as independent values.
+        auto check([&nums](const auto& mV) {
+            using V = std::decay_t<decltype(mV)>;
+            constexpr bool cow{std::is_same_v<V, CowVal>};
+
+            const auto base(V::template fromStr<RSInSituNumArrs>(
+                R"({"a": {"x": 1, "y": [1, 2, 3]},
+                "b": "a string long enough to be allocated", "nums": )" +
+                nums + "}"));
+            const auto y123(V::fromStr("[1, 2, 3]"));
+
+            const auto before(allocCount.load());
+            auto copy(base);
+            TEST_ASSERT_NS((allocCount.load() == before) == cow);
+            TEST_ASSERT_NS(copy.sharesStorageWith(base) == cow);
+            TEST_ASSERT_NS(copy == base);
+
+            copy["a"]["x"] = 2;
+            const auto& cCopy(copy);
+            TEST_ASSERT_NS(base["a"]["x"] == 1 && cCopy["a"]["x"] == 2);
+            TEST_ASSERT_NS(!copy.sharesStorageWith(base));
+            TEST_ASSERT_NS(cCopy["b"].sharesStorageWith(base["b"]) == cow);
+            TEST_ASSERT_NS(
+                cCopy["a"]["y"].sharesStorageWith(base["a"]["y"]) == cow);
+            TEST_ASSERT_NS(diff(base, copy).getSizeArr() == 1);
+
+            // Escaped references never write into other copies
+            auto& a(copy["a"]);
+            const auto snapshot(copy);
+            a["x"] = 3;
+            a["y"].emplace(4);
+            TEST_ASSERT_NS(snapshot["a"]["x"] == 2 && cCopy["a"]["x"] == 3);
+            TEST_ASSERT_NS(snapshot["a"]["y"].getSizeArr() == 3);
+            TEST_ASSERT_NS(base["a"]["y"].getSizeArr() == 3);
+            TEST_ASSERT_NS(
+                snapshot["b"].sharesStorageWith(base["b"]) == cow);
+
+            // Reading does not unshare
+            auto y(base["a"]["y"]);
+            TEST_ASSERT_NS(y.template as<std::vector<int>>()[2] == 3);
+            TEST_ASSERT_NS(getExtr<std::vector<int>>(y).size() == 3);
+            TEST_ASSERT_NS(y.sharesStorageWith(base["a"]["y"]) == cow);
+
+            // Mutable iteration clones shared storage, so it may throw
+            static_assert(!noexcept(std::declval<V&>().forObj()));
+            static_assert(
+                !noexcept(std::declval<V&>().template forArrAs<int>()));
+
+            auto iterated(base);
+            for(auto&& x : iterated["a"]["y"].forArr()) x = 0;
+            TEST_ASSERT_NS(iterated["a"]["y"] == V::fromStr("[0, 0, 0]"));
+            TEST_ASSERT_NS(base["a"]["y"] == y123);
+
+            auto ns(base["nums"]);
+            TEST_ASSERT_NS(ns.sharesStorageWith(base["nums"]) == cow);
+            ns[0] = "x";
+            TEST_ASSERT_NS(ns[0] == "x" && base["nums"][0] == 0);
+            TEST_ASSERT_NS(base["nums"].template isNumArr<IntS>());
+
+            auto patched(base);
+            applyPatch(patched, V::fromStr(R"([{"op": "copy",
+                "from": "/b", "path": "/c"},
+                {"op": "test", "path": "/a/x", "value": 1}])"));
+            TEST_ASSERT_NS(std::as_const(patched)["c"] == base["b"]);
+            TEST_ASSERT_NS(std::as_const(patched)["a"].sharesStorageWith(
+                               base["a"]) == cow);
+
+            // Copies can be made and mutated from multiple threads
+            std::vector<std::thread> threads;
+            std::atomic<int> failures{0};
+            for(auto t(0); t < 4; ++t)
+                threads.emplace_back([&, t] {
+                    for(auto i(0); i < 100; ++i)
+                    {
+                        auto v(base);
+                        v["a"]["x"] = t;
+                        v["a"]["y"].emplace(i);
+                        if(std::as_const(v)["a"]["y"].getSizeArr() != 4 ||
+                            base["a"]["x"] != 1)
+                            ++failures;
+                    }
+                });
+            for(auto& t : threads) t.join();
+            TEST_ASSERT_NS(failures == 0);
+            TEST_ASSERT_NS(base["a"]["y"] == y123);
+        });
+
+        check(Val{});
+        check(CowVal{});
+        static_assert(!std::is_same_v<Val, CowVal>);
+    }
 }
@@ -0,0 +1,692 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#include "SSVUtils/Core/Core.hpp"
+#include "SSVUtils/Json/Json.hpp"
+#include "SSVUtils/Benchmark/Benchmark.hpp"
+#include "./utils/test_utils.hpp"
+
+#include <atomic>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <cstdlib>
+
+namespace
+{
+// Bytes currently allocated through `operator new`
+std::atomic<std::size_t> liveBytes{0};
+
+// Every allocation is prefixed by its size, so that it can be subtracted
+constexpr std::size_t allocHeaderSize{alignof(std::max_align_t)};
+} // namespace
+
+void* operator new(std::size_t mSize)
+{
+    auto p(static_cast<char*>(std::malloc(mSize + allocHeaderSize)));
+    if(p == nullptr) throw std::bad_alloc{};
+
+    *reinterpret_cast<std::size_t*>(p) = mSize;
+    liveBytes.fetch_add(mSize, std::memory_order_relaxed);
+    return p + allocHeaderSize;
+}
+// Not inlined, as GCC would then mistake `std::free` for a mismatched
+// deallocation
+SSVU_ATTRIBUTE(noinline) void operator delete(void* mPtr) noexcept
+{
+    if(mPtr == nullptr) return;
+
+    auto p(static_cast<char*>(mPtr) - allocHeaderSize);
+    liveBytes.fetch_sub(
+        *reinterpret_cast<std::size_t*>(p), std::memory_order_relaxed);
+    std::free(p);
+}
+void operator delete(void* mPtr, std::size_t) noexcept
+{
+    operator delete(mPtr);
+}
+
+namespace
+{
+// Generates a pretty-printed and commented document with `mCount` records,
+// similar to hand-written configuration and replay files.
+std::string makeDoc(std::size_t mCount)
+{
+    std::string result;
+    result += "// Generated benchmark document\n{\n    \"records\":\n    [\n";
+
+    for(auto i(0u); i < mCount; ++i)
+    {
+        auto si(ssvu::toStr(i));
+
+        result += "        // Record " + si + "\n";
+        result += "        {\n";
+        result += "            \"id\": " + si + ",\n";
+        result += "            \"name\": \"record number " + si + "\",\n";
+        result += "            \"enabled\": " +
+                  std::string{i % 2 == 0 ? "true" : "false"} + ",\n";
+        result += "            \"scale\": " + si + ".25,\n";
+        result += "            \"tags\": [ \"a\", \"b\", \"c\" ],\n";
+        result += "            \"parent\": null\n";
+        result += i + 1 < mCount ? "        },\n" : "        }\n";
+    }
+
+    result += "    ]\n}\n";
+    return result;
+}
+
+// Counts the values of a document without building a `Val` tree
+struct CountingHandler : ssvu::Json::SaxHandler
+{
+    std::size_t count{0};
+
+    void onStr(std::string_view)
+    {
+        ++count;
+    }
+    void onNum(const ssvu::Json::Impl::Num&)
+    {
+        ++count;
+    }
+    void onBln(bool)
+    {
+        ++count;
+    }
+    void onNll()
+    {
+        ++count;
+    }
+};
+
+// Typed representation of the documents generated by `makeDoc`
+struct BenchRecord
+{
+    std::size_t id{0};
+    std::string name;
+    bool enabled{false};
+    double scale{0.0};
+    std::vector<std::string> tags;
+};
+
+struct BenchDoc
+{
+    std::vector<BenchRecord> records;
+};
+
+template <typename TF>
+void runBenchmark(const std::string& mTitle, std::size_t mTimes, TF&& mF)
+{
+    ssvu::Benchmark::groupReset(mTitle);
+
+    for(auto i(0u); i < mTimes; ++i)
+    {
+        SSVU_BENCHMARK_RUN_GROUP_SCOPE_EXIT(mTitle);
+        mF();
+    }
+
+    ssvu::Benchmark::groupEndLo(mTitle);
+}
+} // namespace
+
+SSVJ_CNV_OBJ_AUTO(BenchRecord, id, name, enabled, scale, tags)
+SSVJ_CNV_OBJ_AUTO(BenchDoc, records)
+
+int main()
+{
+    using namespace ssvu::Json;
+
+    const auto src(makeDoc(20000));
+    const auto srcPretty(fromStr(src).getWriteToStr<WSPretty>());
+
+    {
+        // Memory used by large arrays of numbers and of short strings
+        constexpr std::size_t count{1000000};
+
+        auto measure([](const std::string& mTitle, auto mNull, auto mFill) {
+            using V = decltype(mNull);
+            const auto before(liveBytes.load());
+
+            typename V::Arr arr;
+            arr.reserve(count);
+            for(auto i(0u); i < count; ++i) mFill(arr, i);
+
+            const V v{std::move(arr)};
+            ssvu::lo(mTitle) << (liveBytes.load() - before) / count
+                             << " bytes per element (" << sizeof(V)
+                             << " bytes per value)\n";
+        });
+
+        auto measureAll([&](const std::string& mSuffix, auto mNull) {
+            measure("Json memory - numbers - " + mSuffix, mNull,
+                [](auto& mArr, std::size_t mI) { mArr.emplace_back(mI); });
+            measure("Json memory - reals - " + mSuffix, mNull,
+                [](auto& mArr, std::size_t mI) {
+                    mArr.emplace_back(mI * 0.5);
+                });
+            measure("Json memory - short strings - " + mSuffix, mNull,
+                [](auto& mArr, std::size_t mI) {
+                    mArr.emplace_back("s" + ssvu::toStr(mI % 1000));
+                });
+        });
+
+        measureAll("Val", Val{});
+        measureAll("CowVal", CowVal{});
+    }
+
+    {
+        // Two-pass reading (copy and purge) vs in-situ reading
+        Val vTwoPass, vInSitu;
+
+        runBenchmark(
+            "Json read - two-pass", 5, [&] { vTwoPass = fromStr(src); });
+        runBenchmark("Json read - in-situ", 5,
+            [&] { vInSitu = fromStr<RSInSitu>(src); });
+
+        TEST_ASSERT_NS(vTwoPass == vInSitu);
+        TEST_ASSERT_NS(vInSitu["records"].getSizeArr() == 20000);
+    }
+
+    {
+        // In-situ reading vs indexed reading, on documents without comments
+        Val vInSitu, vIndexed;
+
+        runBenchmark("Json read (no comments) - in-situ", 5,
+            [&] { vInSitu = fromStr<RSInSitu>(srcPretty); });
+        runBenchmark("Json read (no comments) - indexed", 5,
+            [&] { vIndexed = fromStr<RSIndexed>(srcPretty); });
+
+        TEST_ASSERT_NS(vInSitu == vIndexed);
+
+        // The index pays off when there are many characters between tokens
+        std::string srcText{"["};
+        for(auto i(0); i < 20000; ++i)
+            srcText += (i == 0 ? "{" : ", {") + std::string{R"("id": )"} +
+                       ssvu::toStr(i) + R"(, "body": ")" +
+                       std::string(400, 'a' + i % 26) + R"("})";
+        srcText += "]";
+
+        CountingHandler hInSitu, hIndexed;
+
+        runBenchmark("Json SAX read (long strings) - in-situ", 5, [&] {
+            hInSitu.count = 0;
+            saxFromStr<RSInSitu>(srcText, hInSitu);
+        });
+        runBenchmark("Json SAX read (long strings) - indexed", 5, [&] {
+            hIndexed.count = 0;
+            saxFromStr<RSIndexed>(srcText, hIndexed);
+        });
+
+        TEST_ASSERT_NS(hInSitu.count == 20000 * 2);
+        TEST_ASSERT_NS(hIndexed.count == hInSitu.count);
+    }
+
+    {
+        // DOM reading vs SAX reading
+        Val vDom;
+        CountingHandler handler;
+
+        runBenchmark("Json read (no comments) - DOM", 5,
+            [&] { vDom = fromStr<RSInSitu>(srcPretty); });
+        runBenchmark("Json read (no comments) - SAX", 5, [&] {
+            handler.count = 0;
+            saxFromStr<RSInSitu>(srcPretty, handler);
+        });
+
+        // Every record contains 8 scalar values
+        TEST_ASSERT_NS(handler.count == 20000 * 8);
+    }
+
+    {
+        // `Val` reading vs read-only `Document` reading
+        Val v;
+        Document doc;
+
+        runBenchmark("Json read (no comments) - Val", 5,
+            [&] { v = fromStr<RSInSitu>(srcPretty); });
+        runBenchmark("Json read (no comments) - Document", 5,
+            [&] { doc.readFromStr(std::string_view{srcPretty}); });
+
+        TEST_ASSERT_NS(doc.toVal() == v);
+    }
+
+    {
+        // Destroying a `Val` tree vs freeing a `Document` arena
+        std::vector<Val> vals;
+        std::vector<Document> docs;
+        for(auto i(0); i < 5; ++i)
+        {
+            vals.emplace_back(fromStr<RSInSitu>(srcPretty));
+            docs.emplace_back(Document::fromStr(std::string_view{srcPretty}));
+        }
+
+        runBenchmark("Json free - Val", 5, [&] { vals.pop_back(); });
+        runBenchmark("Json free - Document", 5, [&] { docs.pop_back(); });
+    }
+
+    {
+        // Reading a file into a string vs reading it through a mapping
+        const ssvufs::Path path{"./ssvu_json_benchmark.json"};
+        fromStr(srcPretty).writeToFile<WSPretty>(path);
+
+        Val vStr, vMapped;
+
+        runBenchmark("Json read file - string", 5,
+            [&] { vStr = fromStr<RSInSitu>(path.getContentsAsStr()); });
+        runBenchmark("Json read file - mapped", 5,
+            [&] { vMapped = fromFile<RSInSitu>(path); });
+
+        TEST_ASSERT_NS(vStr == vMapped);
+        ssvufs::removeFile(path);
+    }
+
+    {
+        // Writing through an `std::ostringstream` vs writing directly to a
+        // string or to a buffered file
+        const auto v(fromStr(src));
+        const ssvufs::Path path{"./ssvu_json_benchmark.json"};
+        std::string sStream, sDirect;
+
+        runBenchmark("Json write - ostringstream", 5, [&] {
+            std::ostringstream o;
+            v.writeToStream<WSMinified>(o);
+            sStream = o.str();
+        });
+        runBenchmark("Json write - string", 5,
+            [&] { v.writeToStr<WSMinified>(sDirect); });
+        runBenchmark("Json write - file", 5,
+            [&] { v.writeToFile<WSMinified>(path); });
+
+        TEST_ASSERT_NS(sStream == sDirect);
+        ssvufs::removeFile(path);
+    }
+
+    {
+        // Escaping strings one character at a time vs skipping clean runs
+        std::vector<std::string> strs;
+        for(auto i(0u); i < 20000; ++i)
+        {
+            std::string s(ssvu::getRndI<std::size_t, std::size_t>(8, 200), 'a');
+            if(i % 4 == 0) s[s.size() / 2] = '"';
+            strs.emplace_back(std::move(s));
+        }
+
+        std::string outScalar, outRuns;
+
+        runBenchmark("String escaping - per character", 5, [&] {
+            outScalar.clear();
+            Impl::StrSink sink{outScalar};
+            for(const auto& s : strs)
+                for(auto c : s)
+                    if(Impl::needsEscape(c))
+                        Impl::writeEscape(sink, c);
+                    else
+                        sink.put(c);
+        });
+        runBenchmark("String escaping - runs", 5, [&] {
+            outRuns.clear();
+            Impl::StrSink sink{outRuns};
+            for(const auto& s : strs) Impl::writeEscaped(sink, s);
+        });
+
+        TEST_ASSERT_NS(outScalar == outRuns);
+    }
+
+    {
+        // Writing throughput of each writer specialization
+        const auto v(fromStr(src));
+        std::string sPretty, sMinified, sLog;
+
+        runBenchmark("Json write - pretty", 5,
+            [&] { v.writeToStr<WSPretty>(sPretty); });
+        runBenchmark("Json write - minified", 5,
+            [&] { v.writeToStr<WSMinified>(sMinified); });
+        runBenchmark("Json write - pretty log", 5,
+            [&] { v.writeToStr<WSPrettyLog>(sLog); });
+
+        TEST_ASSERT_NS(fromStr(sPretty) == fromStr(sMinified));
+    }
+
+    {
+        // Text vs binary encoding, in both directions
+        const auto v(fromStr(src));
+        std::string sText, sBin;
+        Val vText, vBin;
+
+        runBenchmark("Json write - text", 5,
+            [&] { v.writeToStr<WSMinified>(sText); });
+        runBenchmark("Json write - binary", 5, [&] { v.writeToBinStr(sBin); });
+        runBenchmark("Json read - text", 5,
+            [&] { vText.readFromStr(std::string_view{sText}); });
+        runBenchmark("Json read - binary", 5,
+            [&] { vBin.readFromBinStr(sBin); });
+
+        TEST_ASSERT_NS(vText == v && vBin == v);
+        TEST_ASSERT_NS(sBin.size() < sText.size());
+    }
+
+    {
+        // NDJSON reading on one thread vs all hardware threads
+        const auto records(fromStr(src)["records"].as<Impl::Arr>());
+        const auto srcNd(getWriteToStrNd(records));
+        std::vector<Val> vSingle, vParallel;
+
+        runBenchmark("NDJson read - single thread", 5,
+            [&] { vSingle = fromStrNd(srcNd, 1); });
+        runBenchmark("NDJson read - parallel", 5,
+            [&] { vParallel = fromStrNd(srcNd); });
+
+        TEST_ASSERT_NS(vSingle == vParallel);
+        TEST_ASSERT_NS(vParallel.size() == 20000);
+    }
+
+    {
+        // Top-level array reading on one thread vs all hardware threads
+        const auto srcArr(
+            Val{fromStr(src)["records"]}.getWriteToStr<WSPretty>());
+        Val vSerial, vParallel;
+
+        runBenchmark("Json array read - serial", 5,
+            [&] { vSerial = fromStr<RSInSitu>(srcArr); });
+        runBenchmark("Json array read - parallel", 5,
+            [&] { vParallel = fromStrParallel<RSInSitu>(srcArr); });
+
+        TEST_ASSERT_NS(vSerial == vParallel);
+    }
+
+    {
+        // Reading a single nested value: full parse vs pointer query
+        const auto pointer(Pointer::fromStr("/records/19000/name"));
+        Val vFull, vQuery;
+
+        runBenchmark("Json single value - full read", 5,
+            [&] { vFull = fromStr<RSInSitu>(src)["records"][19000]["name"]; });
+        runBenchmark("Json single value - query", 5,
+            [&] { vQuery = queryStr(src, pointer); });
+
+        TEST_ASSERT_NS(vFull == vQuery);
+        TEST_ASSERT_NS(vQuery.as<Str>() == "record number 19000");
+    }
+
+    {
+        // Wide objects with unsorted keys: reading and key lookup
+        std::string srcWide{"{"};
+        for(auto i(0); i < 10000; ++i)
+        {
+            const auto k(ssvu::toStr((i * 7919) % 10000));
+            srcWide += (i == 0 ? "\"k" : ", \"k") + k + "\": " + k;
+        }
+        srcWide += "}";
+
+        // `Val` keeps keys sorted, `HashedVal` hashes wide objects
+        const auto benchWide([&](const std::string& mTitle, auto mV)
+            {
+                using V = decltype(mV);
+                std::size_t sum{0};
+
+                runBenchmark(mTitle + " - read", 5,
+                    [&] { mV = V::template fromStr<RSInSitu>(srcWide); });
+                runBenchmark(mTitle + " - lookup", 5, [&] {
+                    sum = 0;
+                    for(auto i(0); i < 10000; ++i)
+                        sum += mV["k" + ssvu::toStr(i)]
+                                   .template as<std::size_t>();
+                });
+
+                TEST_ASSERT_NS(sum == std::size_t(10000) * 9999 / 2);
+            });
+
+        benchWide("Json wide object", Val{});
+        benchWide("Json wide object (hashed)", HashedVal{});
+    }
+
+    {
+        // Records repeating the same keys: `Val` vs `Document`, with keys
+        // viewed in the source or interned
+        std::string srcRecords{"["};
+        for(auto i(0); i < 100000; ++i)
+        {
+            const auto n(ssvu::toStr(i));
+            srcRecords += (i == 0 ? "{" : ", {") +
+                          std::string{R"("identifier": )"} + n +
+                          R"(, "displayName": "r)" + n +
+                          R"(", "category": 1, "enabled": true})";
+        }
+        srcRecords += "]";
+
+        Val vRecords;
+        KeyTable keys;
+        Document docRecords, docInterned{keys};
+        std::size_t sum{0};
+
+        runBenchmark("Json records - Val read", 5,
+            [&] { vRecords = fromStr<RSInSitu>(srcRecords); });
+        runBenchmark("Json records - Document read", 5,
+            [&] { docRecords.readFromStr(std::string_view{srcRecords}); });
+        runBenchmark("Json records - Document read, interned keys", 5,
+            [&] { docInterned.readFromStr(std::string_view{srcRecords}); });
+        runBenchmark("Json records - Val lookup", 5, [&] {
+            sum = 0;
+            for(const auto& r : vRecords.forArr())
+                sum += r["identifier"].as<std::size_t>();
+        });
+        runBenchmark("Json records - Document lookup", 5, [&] {
+            sum = 0;
+            for(auto r : docRecords.getRoot().forArr())
+                sum += r["identifier"].as<std::size_t>();
+        });
+        runBenchmark("Json records - Document lookup, interned key", 5, [&] {
+            const auto key(keys.intern("identifier"));
+
+            sum = 0;
+            for(auto r : docInterned.getRoot().forArr())
+                sum += r[key].as<std::size_t>();
+        });
+
+        TEST_ASSERT_NS(sum == std::size_t(100000) * 99999 / 2);
+        TEST_ASSERT_NS(keys.getSize() == 4);
+    }
+
+    {
+        // Typed reading through a `Val` tree vs streamed typed reading
+        BenchDoc dVal, dStream;
+
+        runBenchmark("Json typed read - Val", 5,
+            [&] { extr(fromStr<RSInSitu>(src), dVal); });
+        runBenchmark("Json typed read - streamed", 5,
+            [&] { extrFromStr<RSInSitu>(src, dStream); });
+
+        TEST_ASSERT_NS(dStream.records.size() == 20000);
+        TEST_ASSERT_NS(getArch(dStream) == getArch(dVal));
+    }
+
+    {
+        // Syncing a copy after a small change: full copy vs diff and patch,
+        // with and without copy-on-write
+        auto bench([&src](const std::string& mTitle, const auto& mV) {
+            using V = std::decay_t<decltype(mV)>;
+
+            const auto base(V::template fromStr<RSInSitu>(src));
+            auto changed(base), synced(base);
+            changed["records"][1234]["scale"] = -1.0;
+            changed["records"][5678]["tags"].emplace("d");
+
+            V patch;
+            runBenchmark(mTitle + " - copy", 5, [&] { synced = changed; });
+            runBenchmark(mTitle + " - diff", 5,
+                [&] { patch = diff(base, changed); });
+
+            // Every run applies the change and reverts it
+            const auto revert(diff(changed, base));
+            synced = base;
+            runBenchmark(mTitle + " - patch", 5, [&] {
+                applyPatch(synced, patch);
+                applyPatch(synced, revert);
+            });
+
+            TEST_ASSERT_NS(patch.getSizeArr() == 2 && synced == base);
+            applyPatch(synced, patch);
+            TEST_ASSERT_NS(synced == changed);
+        });
+
+        bench("Json sync", Val{});
+        bench("Json sync (copy-on-write)", CowVal{});
+    }
+
+    {
+        // Copying a large document and changing one of its values, which
+        // only clones the changed path with copy-on-write
+        auto bench([&src](const std::string& mTitle, const auto& mV) {
+            using V = std::decay_t<decltype(mV)>;
+
+            const auto base(V::template fromStr<RSInSitu>(src));
+            V tweaked;
+
+            runBenchmark(mTitle, 5, [&] {
+                tweaked = base;
+                tweaked["records"][1234]["scale"] = -1.0;
+            });
+
+            TEST_ASSERT_NS(diff(base, tweaked).getSizeArr() == 1);
+        });
+
+        bench("Json copy and tweak", Val{});
+        bench("Json copy and tweak (copy-on-write)", CowVal{});
+    }
+
+    {
+        // Deduplicating small payloads: linear search with `operator==` vs
+        // an unordered set of hashed values
+        std::vector<Val> payloads;
+        for(auto i(0u); i < 20000; ++i)
+            payloads.emplace_back(mkObj("id", i % 500, "kind", "event",
+                "tags", mkArr("a", "b", i % 7 == 0)));
+
+        std::vector<Val> distinctLinear;
+        runBenchmark("Json dedup - linear search", 5, [&] {
+            distinctLinear.clear();
+            for(const auto& p : payloads)
+                if(std::find(std::begin(distinctLinear),
+                       std::end(distinctLinear),
+                       p) == std::end(distinctLinear))
+                    distinctLinear.emplace_back(p);
+        });
+
+        std::unordered_set<Hashed> distinctHashed;
+        runBenchmark("Json dedup - hashed set", 5, [&] {
+            distinctHashed.clear();
+            for(const auto& p : payloads) distinctHashed.emplace(p);
+        });
+
+        TEST_ASSERT_NS(distinctLinear.size() == distinctHashed.size());
+    }
+
+    {
+        // Large arrays of reals: regular arrays vs contiguous numeric arrays
+        std::string srcReals{"["};
+        for(auto i(0); i < 1000000; ++i)
+            srcReals += (i == 0 ? "" : ",") + ssvu::toStr(i) + ".5";
+        srcReals += "]";
+
+        Val vTyped, vGeneric;
+        std::size_t bytesTyped{0}, bytesGeneric{0};
+        Real sumGeneric{0}, sumTyped{0};
+
+        runBenchmark("Json reals - read", 5,
+            [&] { vTyped = fromStr<RSInSituNumArrs>(srcReals); });
+
+        // Memory is measured from scratch, once for each representation
+        vTyped = Val{};
+        {
+            const auto before(liveBytes.load());
+            vTyped = fromStr<RSInSituNumArrs>(srcReals);
+            bytesTyped = liveBytes.load() - before;
+        }
+        {
+            const auto& items(std::as_const(vTyped).as<Impl::Arr>());
+
+            const auto before(liveBytes.load());
+            vGeneric = Val{Impl::Arr(items)};
+            bytesGeneric = liveBytes.load() - before;
+        }
+
+        runBenchmark("Json reals - sum, regular array", 5, [&] {
+            sumGeneric = 0;
+            for(const auto& x : vGeneric.forArrAs<Real>()) sumGeneric += x;
+        });
+        runBenchmark("Json reals - sum, numeric array", 5, [&] {
+            sumTyped = 0;
+            for(auto x : vTyped.getNumArr<Real>()) sumTyped += x;
+        });
+
+        ssvu::lo("Json reals - memory")
+            << bytesGeneric / 1000000 << " bytes per element (regular), "
+            << bytesTyped / 1000000 << " bytes per element (numeric)\n";
+
+        TEST_ASSERT_NS(vTyped.isNumArr<Real>() && vTyped == vGeneric);
+        TEST_ASSERT_NS(sumGeneric == sumTyped);
+    }
+
+    {
+        // Number parsing: `strtod` vs the built-in parser
+        std::vector<std::string> nums;
+        for(auto i(0u); i < 200000; ++i)
+        {
+            nums.emplace_back(ssvu::toStr(i * 7919u));
+            nums.emplace_back(ssvu::toStr(i) + "." + ssvu::toStr(i * 31u));
+            nums.emplace_back("-" + ssvu::toStr(i % 997) + ".5e-" +
+                              ssvu::toStr(i % 300));
+        }
+
+        Real sumStrtod{0}, sumParser{0};
+
+        runBenchmark("Number parsing - strtod", 5, [&] {
+            sumStrtod = 0;
+            for(const auto& n : nums)
+                sumStrtod += std::strtod(n.c_str(), nullptr);
+        });
+        runBenchmark("Number parsing - parser", 5, [&] {
+            sumParser = 0;
+            Impl::Num num;
+            for(const auto& n : nums)
+            {
+                Impl::strToNum(n, num);
+                sumParser += num.as<Real>();
+            }
+        });
+
+        TEST_ASSERT_NS(sumStrtod == sumParser);
+    }
+
+    {
+        // Real formatting: `std::ostringstream` vs the shortest round-trip
+        // formatter
+        std::vector<Real> reals;
+        for(auto i(0u); i < 200000; ++i)
+            reals.emplace_back(ssvu::getRndR<Real>(-1e6, 1e6));
+
+        std::size_t sizeStream{0}, sizeFast{0};
+
+        runBenchmark("Real formatting - ostringstream", 5, [&] {
+            std::ostringstream o;
+            o << std::setprecision(17);
+            for(auto r : reals) o << r << ',';
+            sizeStream = o.str().size();
+        });
+        runBenchmark("Real formatting - shortest", 5, [&] {
+            std::string o;
+            for(auto r : reals)
+            {
+                o += ssvu::toStr(r);
+                o += ',';
+            }
+            sizeFast = o.size();
+        });
+
+        TEST_ASSERT_NS(sizeFast <= sizeStream);
+    }
+}
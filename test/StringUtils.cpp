@@ -84,4 +84,25 @@ int main()
         TEST_ASSERT_OP(ssvu::toStr(is), ==, std::to_string(is));
         TEST_ASSERT_OP(ssvu::toStr(iu), ==, std::to_string(iu));
     }
+
+    // Fast integer tests at the limits of the types
+    TEST_ASSERT_OP(ssvu::toStr(std::numeric_limits<long>::min()), ==,
+        std::to_string(std::numeric_limits<long>::min()));
+    TEST_ASSERT_OP(ssvu::toStr(std::numeric_limits<unsigned long>::max()), ==,
+        std::to_string(std::numeric_limits<unsigned long>::max()));
+
+    // Fast double tests
+    TEST_ASSERT(toStr(100.0) == "100");
+    TEST_ASSERT(toStr(0.1) == "0.1");
+    TEST_ASSERT(toStr(-2.5e-7) == "-2.5e-7");
+    TEST_ASSERT(toStr(1e21) == "1e+21");
+    TEST_ASSERT(toStr(5e-324) == "5e-324");
+
+    for(auto i(0u); i < 100; ++i)
+    {
+        auto d(ssvu::getRndR<double>(-1e10, 1e10) *
+               std::pow(10.0, ssvu::getRndI<int, int>(-300, 290)));
+
+        TEST_ASSERT_OP(std::strtod(ssvu::toStr(d).c_str(), nullptr), ==, d);
+    }
 }